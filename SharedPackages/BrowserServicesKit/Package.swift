@@ -14,6 +14,7 @@ let package = Package(
         // Exported libraries
         .library(name: "BrowserServicesKit", targets: ["BrowserServicesKit"]),
         .library(name: "Common", targets: ["Common"]),
+        .library(name: "CommonTracing", targets: ["CommonTracing"]),
         .library(name: "DDGSync", targets: ["DDGSync"]),
         .library(name: "BrowserServicesKitTestsUtils", targets: ["BrowserServicesKitTestsUtils"]),
         .library(name: "Persistence", targets: ["Persistence"]),
@@ -208,9 +209,13 @@ let package = Package(
             ],
             path: "Sources/SyncMetadataTestDBBuilder"
         ),
+        .target(
+            name: "CommonTracing"
+        ),
         .target(
             name: "Common",
             dependencies: [
+                "CommonTracing",
                 .product(name: "Punycode", package: "PunycodeSwift"),
             ],
             resources: [
@@ -229,6 +234,14 @@ let package = Package(
                 .define("DEBUG", .when(configuration: .debug))
             ]
         ),
+        .executableTarget(
+            name: "ContentBlockerRulesBenchmark",
+            dependencies: [
+                "ContentBlocking",
+                "TrackerRadarKit",
+            ],
+            path: "Sources/ContentBlockerRulesBenchmark"
+        ),
         .target(
             name: "Navigation",
             dependencies: [
@@ -549,6 +562,7 @@ let package = Package(
             name: "CrashesTests",
             dependencies: [
                 "Crashes",
+                "CxxCrashHandler",
                 "PersistenceTestingUtils"
             ]
         ),
@@ -572,6 +586,12 @@ let package = Package(
                 .product(name: "DDGSyncCrypto", package: "sync_crypto"),
             ]
         ),
+        .testTarget(
+            name: "CommonTracingTests",
+            dependencies: [
+                "CommonTracing",
+            ]
+        ),
         .testTarget(
             name: "CommonTests",
             dependencies: [
@@ -21,6 +21,7 @@ import WebKit
 import TrackerRadarKit
 import Combine
 import Common
+import ContentBlocking
 import os.log
 
 public protocol CompiledRuleListsSource {
@@ -65,6 +66,13 @@ public class ContentBlockerRulesManager: CompiledRuleListsSource {
         public let etag: String
         public let identifier: ContentBlockerRulesIdentifier
 
+        private let lazyTrackerDataIndex: LazyTrackerDataIndex
+
+        /// Suffix index over `trackerData`, built on first use and shared by all copies of these rules.
+        public var trackerDataIndex: TrackerDataIndex {
+            lazyTrackerDataIndex.index
+        }
+
         public init(name: String,
                     rulesList: WKContentRuleList,
                     trackerData: TrackerData,
@@ -77,6 +85,7 @@ public class ContentBlockerRulesManager: CompiledRuleListsSource {
             self.encodedTrackerData = encodedTrackerData
             self.etag = etag
             self.identifier = identifier
+            self.lazyTrackerDataIndex = LazyTrackerDataIndex(trackerData: trackerData)
         }
 
         internal init(compilationResult: CompilationResult) {
@@ -135,14 +144,19 @@ public class ContentBlockerRulesManager: CompiledRuleListsSource {
 
     private let lastCompiledRulesStore: LastCompiledRulesStore?
 
+    /// When set, rule lists are generated in content-addressed shards and only shards affected by a change are regenerated.
+    private let shardGenerator: ContentBlockerRulesShardGenerator?
+
     public init(rulesSource: ContentBlockerRulesListsSource,
                 exceptionsSource: ContentBlockerRulesExceptionsSource,
                 lastCompiledRulesStore: LastCompiledRulesStore? = nil,
+                shardCache: ContentBlockerRulesShardCaching? = nil,
                 cache: ContentBlockerRulesCaching? = nil,
                 errorReporting: EventMapping<ContentBlockerDebugEvents>? = nil) {
         self.rulesSource = rulesSource
         self.exceptionsSource = exceptionsSource
         self.lastCompiledRulesStore = lastCompiledRulesStore
+        self.shardGenerator = shardCache.map { ContentBlockerRulesShardGenerator(cache: $0) }
         self.cache = cache
         self.errorReporting = errorReporting
 
@@ -304,7 +318,8 @@ public class ContentBlockerRulesManager: CompiledRuleListsSource {
 
             return CompilationTask(workQueue: workQueue,
                                    rulesList: sourceManager.rulesList,
-                                   sourceManager: sourceManager)
+                                   sourceManager: sourceManager,
+                                   shardGenerator: shardGenerator)
         }
 
         executeNextTask()
@@ -17,6 +17,7 @@
 //
 
 import Common
+import ContentBlocking
 import Foundation
 import WebKit
 import TrackerRadarKit
@@ -56,6 +57,7 @@ extension ContentBlockerRulesManager {
         let workQueue: DispatchQueue
         let rulesList: ContentBlockerRulesList
         let sourceManager: ContentBlockerRulesSourceManager
+        let shardGenerator: ContentBlockerRulesShardGenerator?
         var isCompleted: Bool { result != nil || compilationImpossible }
         private(set) var compilationImpossible = false
         private(set) var result: CompilationResult?
@@ -63,10 +65,12 @@ extension ContentBlockerRulesManager {
 
         init(workQueue: DispatchQueue,
              rulesList: ContentBlockerRulesList,
-             sourceManager: ContentBlockerRulesSourceManager) {
+             sourceManager: ContentBlockerRulesSourceManager,
+             shardGenerator: ContentBlockerRulesShardGenerator? = nil) {
             self.workQueue = workQueue
             self.rulesList = rulesList
             self.sourceManager = sourceManager
+            self.shardGenerator = shardGenerator
         }
 
         func start(ignoreCache: Bool = false, completionHandler: @escaping Completion) {
@@ -144,27 +148,27 @@ extension ContentBlockerRulesManager {
                              completionHandler: @escaping Completion) {
             Logger.contentBlocking.log("Starting CBR compilation for \(self.rulesList.name, privacy: .public)")
 
-            let builder = ContentBlockerRulesBuilder(trackerData: model.tds)
-            let rules = builder.buildRules(withExceptions: model.unprotectedSites,
-                                           andTemporaryUnprotectedDomains: model.tempList,
-                                           andTrackerAllowlist: model.allowList)
-
-            let data: Data
+            let ruleList: String
+            let shardOutput: ContentBlockerRulesShardGenerator.Output?
             do {
-                data = try JSONEncoder().encode(rules)
+                (ruleList, shardOutput) = try encodeRules(model: model)
             } catch {
                 Logger.contentBlocking.error("❌ Failed to encode content blocking rules \(self.rulesList.name, privacy: .public)")
                 compilationFailed(for: model, with: error, completionHandler: completionHandler)
                 return
             }
 
-            let ruleList = String(data: data, encoding: .utf8)!
             DispatchQueue.main.async {
                 WKContentRuleListStore.default().compileContentRuleList(forIdentifier: model.rulesIdentifier.stringValue,
                                                                         encodedContentRuleList: ruleList) { ruleList, error in
 
                     if let ruleList = ruleList {
                         Logger.contentBlocking.log("🟢 CBR compilation for \(self.rulesList.name, privacy: .public) succeeded")
+                        if let shardOutput {
+                            self.workQueue.async {
+                                self.shardGenerator?.removeUnusedShards(keeping: shardOutput, listName: self.rulesList.name)
+                            }
+                        }
                         self.compilationSucceeded(with: ruleList,
                                                   model: model,
                                                   resultType: .rulesCompilation,
@@ -178,6 +182,25 @@ extension ContentBlockerRulesManager {
             }
         }
 
+        private func encodeRules(model: ContentBlockerRulesSourceModel) throws -> (String, ContentBlockerRulesShardGenerator.Output?) {
+            if let shardGenerator {
+                let output = try shardGenerator.generate(trackerData: model.tds,
+                                                         unprotectedSites: model.unprotectedSites,
+                                                         tempList: model.tempList,
+                                                         allowList: model.allowList,
+                                                         listName: rulesList.name)
+                Logger.contentBlocking.log("Regenerated \(output.regeneratedShards.count, privacy: .public)/\(output.shardDigests.count, privacy: .public) rule shards for \(self.rulesList.name, privacy: .public)")
+                return (output.encodedRulesString, output)
+            }
+
+            let builder = ContentBlockerRulesBuilder(trackerData: model.tds)
+            let rules = builder.buildRules(withExceptions: model.unprotectedSites,
+                                           andTemporaryUnprotectedDomains: model.tempList,
+                                           andTrackerAllowlist: model.allowList)
+            let data = try JSONEncoder().encode(rules)
+            return (String(data: data, encoding: .utf8)!, nil)
+        }
+
         func getCompilationResult(ruleList: WKContentRuleList,
                                   model: ContentBlockerRulesSourceModel,
                                   resultType: CompilationResult.ResultType) -> CompilationResult {
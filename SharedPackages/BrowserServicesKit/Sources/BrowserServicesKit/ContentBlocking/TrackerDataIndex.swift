@@ -0,0 +1,243 @@
+//
+//  TrackerDataIndex.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Common
+import Foundation
+import TrackerRadarKit
+
+/// Immutable reverse-label trie over trackers, entity domains and cnames of a single `TrackerData` set.
+///
+/// Answers the same queries as `TrackerDataQueryExtension` but resolves the longest matching suffix of a host
+/// in a single walk over its labels, without building intermediate strings or arrays.
+/// Like `TrackerData` queries, a bare top level label (e.g. `com`) never matches.
+public final class TrackerDataIndex {
+
+    /// Result of classifying a single request host.
+    public struct Classification {
+        public let tracker: KnownTracker?
+        public let cnameTracker: KnownTracker?
+        public let entity: Entity?
+    }
+
+    private final class Node {
+        var children = [Substring: Node]()
+
+        var tracker: KnownTracker?
+        var cname: String?
+
+        // Entity associated through `TrackerData.domains`, resolved at build time.
+        var hasEntityDomain = false
+        var entity: Entity?
+
+        // Precomputed answer for `findParentEntityOrFallback(forHost:)`.
+        var hasParentEntityOrFallback = false
+        var parentEntityOrFallback: Entity?
+
+        func child(for label: Substring) -> Node {
+            if let node = children[label] {
+                return node
+            }
+            let node = Node()
+            children[label] = node
+            return node
+        }
+    }
+
+    public let trackerData: TrackerData
+    private let root = Node()
+
+    public init(trackerData: TrackerData) {
+        self.trackerData = trackerData
+
+        var nodes = [Node]()
+        nodes.reserveCapacity(trackerData.trackers.count + trackerData.domains.count)
+
+        for (domain, tracker) in trackerData.trackers {
+            let node = insert(domain)
+            node.tracker = tracker
+            nodes.append(node)
+        }
+
+        for (domain, entityName) in trackerData.domains {
+            let node = insert(domain)
+            node.hasEntityDomain = true
+            node.entity = trackerData.entities[entityName]
+            nodes.append(node)
+        }
+
+        for (domain, cname) in trackerData.cnames ?? [:] {
+            insert(domain).cname = cname
+        }
+
+        for node in nodes {
+            if let ownedBy = node.tracker?.owner?.ownedBy {
+                node.hasParentEntityOrFallback = true
+                node.parentEntityOrFallback = trackerData.entities[ownedBy]
+            } else if node.hasEntityDomain {
+                node.hasParentEntityOrFallback = true
+                node.parentEntityOrFallback = node.entity
+            }
+        }
+    }
+
+    private func insert(_ domain: String) -> Node {
+        var node = root
+        for label in domain.split(separator: ".", omittingEmptySubsequences: false).reversed() {
+            node = node.child(for: label)
+        }
+        return node
+    }
+
+    /// Walks the trie from the last label of `host` towards the first, calling `body` for every node that
+    /// represents a suffix of at least two labels. Nodes are visited from the shortest to the longest suffix.
+    private func walk(_ host: Substring, _ body: (Node) -> Void) {
+        var node = root
+        var end = host.endIndex
+        var depth = 0
+
+        while true {
+            let start = host[..<end].lastIndex(of: ".").map { host.index(after: $0) } ?? host.startIndex
+            guard let next = node.children[host[start..<end]] else { return }
+            node = next
+            depth += 1
+            if depth > 1 {
+                body(node)
+            }
+            guard start > host.startIndex else { return }
+            end = host.index(before: start)
+        }
+    }
+
+    public func findTracker(forHost host: String) -> KnownTracker? {
+        var result: KnownTracker?
+        walk(host[...]) { node in
+            if let tracker = node.tracker {
+                result = tracker
+            }
+        }
+        return result
+    }
+
+    public func findTracker(forUrl url: String) -> KnownTracker? {
+        guard let host = URL(string: url)?.host else { return nil }
+        return findTracker(forHost: host)
+    }
+
+    public func findEntity(forHost host: String) -> Entity? {
+        var result: Entity?
+        walk(host[...]) { node in
+            if node.hasEntityDomain {
+                result = node.entity
+            }
+        }
+        return result
+    }
+
+    public func findEntity(byName name: String) -> Entity? {
+        trackerData.findEntity(byName: name)
+    }
+
+    /// Returns the parent of the entity associated with the host if any. If the entity associated with the host doesn't have a parent return the entity. Otherwise, return nil.
+    public func findParentEntityOrFallback(forHost host: String) -> Entity? {
+        var result: Entity?
+        walk(host[...]) { node in
+            if node.hasParentEntityOrFallback {
+                result = node.parentEntityOrFallback
+            }
+        }
+        return result
+    }
+
+    public func findTrackerByCname(forHost host: String) -> KnownTracker? {
+        var cname: String?
+        walk(host[...]) { node in
+            if let nodeCname = node.cname {
+                cname = nodeCname
+            }
+        }
+        guard let cname else { return nil }
+        return trackerData.findTracker(byCname: cname)?.copy(withNewDomain: cname)
+    }
+
+    public func findTrackerByCname(forUrl url: String) -> KnownTracker? {
+        guard let host = URL(string: url)?.host else { return nil }
+        return findTrackerByCname(forHost: host)
+    }
+
+    /// Classifies request hosts in one pass each, returning results in the order of `hosts`.
+    /// Cname trackers are only resolved for hosts that are not trackers themselves.
+    public func classify(hosts: [String]) -> [Classification] {
+        var results = [Classification]()
+        results.reserveCapacity(hosts.count)
+
+        for host in hosts {
+            var tracker: KnownTracker?
+            var cname: String?
+            var hasEntityDomain = false
+            var entity: Entity?
+
+            walk(host[...]) { node in
+                if let nodeTracker = node.tracker {
+                    tracker = nodeTracker
+                }
+                if let nodeCname = node.cname {
+                    cname = nodeCname
+                }
+                if node.hasEntityDomain {
+                    hasEntityDomain = true
+                    entity = node.entity
+                }
+            }
+
+            var cnameTracker: KnownTracker?
+            if tracker == nil, let cname {
+                cnameTracker = trackerData.findTracker(byCname: cname)?.copy(withNewDomain: cname)
+            }
+
+            results.append(Classification(tracker: tracker,
+                                          cnameTracker: cnameTracker,
+                                          entity: hasEntityDomain ? entity : nil))
+        }
+
+        return results
+    }
+
+}
+
+/// Builds a `TrackerDataIndex` on first access.
+final class LazyTrackerDataIndex {
+
+    private let trackerData: TrackerData
+    private let lock = NSLock()
+    private var _index: TrackerDataIndex?
+
+    init(trackerData: TrackerData) {
+        self.trackerData = trackerData
+    }
+
+    var index: TrackerDataIndex {
+        lock.lock(); defer { lock.unlock() }
+        if let index = _index {
+            return index
+        }
+        let index = TrackerDataIndex(trackerData: trackerData)
+        _index = index
+        return index
+    }
+
+}
@@ -50,6 +50,7 @@ public class TrackerDataManager {
         set {
             lock.lock()
             _fetchedData = newValue
+            _dataGeneration += 1
             lock.unlock()
         }
     }
@@ -58,26 +59,29 @@ public class TrackerDataManager {
     private(set) public var embeddedData: DataSet {
         get {
             lock.lock()
-            let data: DataSet
-            // List is loaded lazily when needed
-            if let embedded = _embeddedData {
-                data = embedded
-            } else {
-                let embedded = embeddedDataProvider.embeddedData
-                let trackerData = try? JSONDecoder().decode(TrackerData.self, from: embedded)
-                _embeddedData = (trackerData!, embeddedDataProvider.embeddedDataEtag)
-                data = _embeddedData
-            }
+            let data = loadEmbeddedDataLocked()
             lock.unlock()
             return data
         }
         set {
             lock.lock()
             _embeddedData = newValue
+            _dataGeneration += 1
             lock.unlock()
         }
     }
 
+    // List is loaded lazily when needed
+    private func loadEmbeddedDataLocked() -> DataSet {
+        if let embedded = _embeddedData {
+            return embedded
+        }
+        let embedded = embeddedDataProvider.embeddedData
+        let trackerData = try? JSONDecoder().decode(TrackerData.self, from: embedded)
+        _embeddedData = (trackerData!, embeddedDataProvider.embeddedDataEtag)
+        return _embeddedData
+    }
+
     public var trackerData: TrackerData {
         if let data = fetchedData {
             return data.tds
@@ -85,6 +89,29 @@ public class TrackerDataManager {
         return embeddedData.tds
     }
 
+    // Incremented whenever fetched or embedded data is replaced
+    private var _dataGeneration = 0
+    private let indexLock = NSLock()
+    private var _trackerDataIndex: (generation: Int, index: TrackerDataIndex)?
+
+    /// Suffix index over `trackerData`, built once per data set.
+    public var trackerDataIndex: TrackerDataIndex {
+        indexLock.lock()
+        defer { indexLock.unlock() }
+
+        lock.lock()
+        let generation = _dataGeneration
+        let dataSet = _fetchedData ?? loadEmbeddedDataLocked()
+        lock.unlock()
+
+        if let cached = _trackerDataIndex, cached.generation == generation {
+            return cached.index
+        }
+        let index = TrackerDataIndex(trackerData: dataSet.tds)
+        _trackerDataIndex = (generation, index)
+        return index
+    }
+
     private let embeddedDataProvider: EmbeddedDataProvider
     private let errorReporting: EventMapping<ContentBlockerDebugEvents>?
 
@@ -124,3 +151,15 @@ public class TrackerDataManager {
         return result
     }
 }
+
+extension TrackerDataManager {
+
+    /// Loads the tracker data published in a protection data snapshot, if it's not loaded already.
+    /// - Returns: `nil` if the snapshot has no tracker data or it's already loaded.
+    @discardableResult
+    public func reload(from snapshot: ProtectionDataSnapshot) -> ReloadResult? {
+        guard let trackerData = snapshot.trackerData, trackerData.etag != fetchedData?.etag else { return nil }
+        return reload(etag: trackerData.etag, data: trackerData.data)
+    }
+
+}
@@ -38,29 +38,40 @@ public protocol ContentBlockerUserScriptConfig: UserScriptSourceProviding {
     var privacyConfiguration: PrivacyConfiguration { get }
     var trackerData: TrackerData? { get }
     var ctlTrackerData: TrackerData? { get }
+    /// Index over `trackerData` used for per-request tracker lookups
+    var trackerDataIndex: TrackerDataIndex? { get }
     var tld: TLD { get }
 }
 
+public extension ContentBlockerUserScriptConfig {
+    var trackerDataIndex: TrackerDataIndex? { nil }
+}
+
 public class DefaultContentBlockerUserScriptConfig: ContentBlockerUserScriptConfig {
 
     public let privacyConfiguration: PrivacyConfiguration
     public let trackerData: TrackerData?
     public let ctlTrackerData: TrackerData?
+    public let trackerDataIndex: TrackerDataIndex?
     public let tld: TLD
 
     public private(set) var source: String
 
+    /// - Parameter trackerDataIndex: index over `trackerData`, e.g. `ContentBlockerRulesManager.Rules.trackerDataIndex`
     public init(privacyConfiguration: PrivacyConfiguration,
                 trackerData: TrackerData?, // This should be non-optional
                 ctlTrackerData: TrackerData?,
                 tld: TLD,
-                trackerDataManager: TrackerDataManager? = nil) {
+                trackerDataManager: TrackerDataManager? = nil,
+                trackerDataIndex: TrackerDataIndex? = nil) {
 
         if trackerData == nil {
             // Fallback to embedded
             self.trackerData = trackerDataManager?.trackerData
+            self.trackerDataIndex = trackerDataManager?.trackerDataIndex
         } else {
             self.trackerData = trackerData
+            self.trackerDataIndex = trackerDataIndex
         }
 
         self.privacyConfiguration = privacyConfiguration
@@ -167,10 +178,18 @@ open class ContentBlockerRulesUserScript: NSObject, UserScript {
             }
         }
 
-        let resolver = TrackerResolver(tds: currentTrackerData,
+        let resolver: TrackerResolver
+        if let trackerDataIndex = configuration.trackerDataIndex {
+            resolver = TrackerResolver(tdsIndex: trackerDataIndex,
                                        unprotectedSites: privacyConfiguration.userUnprotectedDomains,
                                        tempList: temporaryUnprotectedDomains,
                                        tld: configuration.tld)
+        } else {
+            resolver = TrackerResolver(tds: currentTrackerData,
+                                       unprotectedSites: privacyConfiguration.userUnprotectedDomains,
+                                       tempList: temporaryUnprotectedDomains,
+                                       tld: configuration.tld)
+        }
 
         if let tracker = resolver.trackerFromUrl(trackerUrlString,
                                                  pageUrlString: pageUrlStr,
@@ -186,7 +205,7 @@ open class ContentBlockerRulesUserScript: NSObject, UserScript {
             guard let requestETLDp1 = configuration.tld.eTLDplus1(forStringURL: trackerUrlString),
                   !isFirstParty(requestURL: trackerUrlString, websiteURL: pageUrlStr) else { return }
 
-            let entity = currentTrackerData.findEntity(forHost: requestETLDp1) ?? Entity(displayName: requestETLDp1, domains: nil, prevalence: nil)
+            let entity = resolver.findEntity(forHost: requestETLDp1) ?? Entity(displayName: requestETLDp1, domains: nil, prevalence: nil)
             let isAffiliated = resolver.isPageAffiliatedWithTrackerEntity(pageUrlString: pageUrlStr, trackerEntity: entity)
 
             let thirdPartyRequest = DetectedRequest(url: trackerUrlString,
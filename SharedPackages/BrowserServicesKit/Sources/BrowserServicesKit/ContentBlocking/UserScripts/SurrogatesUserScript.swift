@@ -38,16 +38,23 @@ public protocol SurrogatesUserScriptConfig: UserScriptSourceProviding {
     var surrogates: String { get }
     var trackerData: TrackerData? { get }
     var encodedSurrogateTrackerData: String? { get }
+    /// Index over `trackerData` used for per-request tracker lookups
+    var trackerDataIndex: TrackerDataIndex? { get }
     var tld: TLD { get }
 
 }
 
+public extension SurrogatesUserScriptConfig {
+    var trackerDataIndex: TrackerDataIndex? { nil }
+}
+
 public class DefaultSurrogatesUserScriptConfig: SurrogatesUserScriptConfig {
 
     public let privacyConfig: PrivacyConfiguration
     public let surrogates: String
     public let trackerData: TrackerData?
     public let encodedSurrogateTrackerData: String?
+    public let trackerDataIndex: TrackerDataIndex?
     public let tld: TLD
 
     public let source: String
@@ -58,11 +65,13 @@ public class DefaultSurrogatesUserScriptConfig: SurrogatesUserScriptConfig {
                 encodedSurrogateTrackerData: String?,
                 trackerDataManager: TrackerDataManager,
                 tld: TLD,
-                isDebugBuild: Bool) {
+                isDebugBuild: Bool,
+                trackerDataIndex: TrackerDataIndex? = nil) {
 
         if trackerData == nil {
             // Fallback to embedded
             self.trackerData = trackerDataManager.trackerData
+            self.trackerDataIndex = trackerDataManager.trackerDataIndex
 
             let surrogateTDS = ContentBlockerRulesManager.extractSurrogates(from: trackerDataManager.trackerData)
             let encodedData = try? JSONEncoder().encode(surrogateTDS)
@@ -70,6 +79,7 @@ public class DefaultSurrogatesUserScriptConfig: SurrogatesUserScriptConfig {
             self.encodedSurrogateTrackerData = encodedTrackerData
         } else {
             self.trackerData = trackerData
+            self.trackerDataIndex = trackerDataIndex
             self.encodedSurrogateTrackerData = encodedSurrogateTrackerData
         }
 
@@ -154,9 +164,16 @@ open class SurrogatesUserScript: NSObject, UserScript, WKScriptMessageHandlerWit
     }
 
     private func trackerFromUrl(_ urlString: String, pageUrlString: String, _ blocked: Bool) -> DetectedRequest {
-        let currentTrackerData = configuration.trackerData
-        let knownTracker = currentTrackerData?.findTracker(forUrl: urlString)
-        let entity = currentTrackerData?.findEntity(byName: knownTracker?.owner?.name ?? "")
+        let knownTracker: KnownTracker?
+        let entity: Entity?
+        if let trackerDataIndex = configuration.trackerDataIndex {
+            knownTracker = trackerDataIndex.findTracker(forUrl: urlString)
+            entity = trackerDataIndex.findEntity(byName: knownTracker?.owner?.name ?? "")
+        } else {
+            let currentTrackerData = configuration.trackerData
+            knownTracker = currentTrackerData?.findTracker(forUrl: urlString)
+            entity = currentTrackerData?.findEntity(byName: knownTracker?.owner?.name ?? "")
+        }
 
         let eTLDp1 = configuration.tld.eTLDplus1(forStringURL: urlString)
         return DetectedRequest(url: urlString,
@@ -24,6 +24,7 @@ import ContentBlocking
 public class TrackerResolver {
 
     let tds: TrackerData
+    let tdsIndex: TrackerDataIndex?
     let unprotectedSites: [String]
     let tempList: [String]
     let tld: TLD
@@ -35,6 +36,21 @@ public class TrackerResolver {
                 tld: TLD,
                 adClickAttributionVendor: String? = nil) {
         self.tds = tds
+        self.tdsIndex = nil
+        self.unprotectedSites = unprotectedSites
+        self.tempList = tempList
+        self.tld = tld
+        self.adClickAttributionVendor = adClickAttributionVendor
+    }
+
+    /// Resolves trackers using a prebuilt index, e.g. `ContentBlockerRulesManager.Rules.trackerDataIndex`.
+    public init(tdsIndex: TrackerDataIndex,
+                unprotectedSites: [String],
+                tempList: [String],
+                tld: TLD,
+                adClickAttributionVendor: String? = nil) {
+        self.tds = tdsIndex.trackerData
+        self.tdsIndex = tdsIndex
         self.unprotectedSites = unprotectedSites
         self.tempList = tempList
         self.tld = tld
@@ -45,11 +61,14 @@ public class TrackerResolver {
                                pageUrlString: String,
                                resourceType: String,
                                potentiallyBlocked: Bool) -> DetectedRequest? {
+        let span = Tracer.beginSpan("TrackerResolver.trackerFromUrl")
+        defer { span.end() }
+
         var trackerUrlString = trackerUrlString
         let tracker: KnownTracker
-        if let regularTracker = tds.findTracker(forUrl: trackerUrlString) {
+        if let regularTracker = findTracker(forUrl: trackerUrlString) {
             tracker = regularTracker
-        } else if let cnamedTracker = tds.findTrackerByCname(forUrl: trackerUrlString),
+        } else if let cnamedTracker = findTrackerByCname(forUrl: trackerUrlString),
                   let originalTrackerURL = URL(string: trackerUrlString),
                   let cnamedTrackerURL = originalTrackerURL.replacing(host: cnamedTracker.domain) {
             tracker = cnamedTracker
@@ -87,12 +106,33 @@ public class TrackerResolver {
 
     public func isPageAffiliatedWithTrackerEntity(pageUrlString: String, trackerEntity: Entity) -> Bool {
         guard let pageHost = URL(string: pageUrlString)?.host,
-              let pageEntity = tds.findEntity(forHost: pageHost)
+              let pageEntity = findEntity(forHost: pageHost)
         else { return false }
 
         return pageEntity.displayName == trackerEntity.displayName
     }
 
+    private func findTracker(forUrl url: String) -> KnownTracker? {
+        if let tdsIndex {
+            return tdsIndex.findTracker(forUrl: url)
+        }
+        return tds.findTracker(forUrl: url)
+    }
+
+    private func findTrackerByCname(forUrl url: String) -> KnownTracker? {
+        if let tdsIndex {
+            return tdsIndex.findTrackerByCname(forUrl: url)
+        }
+        return tds.findTrackerByCname(forUrl: url)
+    }
+
+    func findEntity(forHost host: String) -> Entity? {
+        if let tdsIndex {
+            return tdsIndex.findEntity(forHost: host)
+        }
+        return tds.findEntity(forHost: host)
+    }
+
     private func calculateBlockingState(tracker: KnownTracker,
                                         trackerUrlString: String,
                                         resourceType: String,
@@ -16,6 +16,7 @@
 //  limitations under the License.
 //
 
+import Common
 import Foundation
 
 public class LinkCleaner {
@@ -26,6 +27,10 @@ public class LinkCleaner {
     private let privacyManager: PrivacyConfigurationManaging
     private var privacyConfig: PrivacyConfiguration { privacyManager.privacyConfig }
 
+    // Tracking parameters compiled for the privacy config revision they were read from.
+    private let compiledTrackingParametersLock = NSLock()
+    private var compiledTrackingParameters: (configIdentifier: String, matcher: TrackingParametersMatcher)?
+
     public init(privacyManager: PrivacyConfigurationManaging) {
         self.privacyManager = privacyManager
     }
@@ -85,6 +90,9 @@ public class LinkCleaner {
     }
 
     public func cleanTrackingParameters(initiator: URL?, url: URL?) -> URL? {
+        let span = Tracer.beginSpan("LinkCleaner.cleanTrackingParameters")
+        defer { span.end() }
+
         urlParametersRemoved = false
         guard privacyConfig.isEnabled(featureKey: .trackingParameters) else { return url }
         guard let url = url, !isURLExcluded(url: url, feature: .trackingParameters) else { return url }
@@ -92,28 +100,29 @@ public class LinkCleaner {
             return url
         }
 
-        guard var urlsComps = URLComponents(url: url, resolvingAgainstBaseURL: false) else {
-            return url
-        }
-        guard let queryParams = urlsComps.percentEncodedQueryItems, queryParams.count > 0 else {
+        // Only URLs that carry tracking parameters pay for building the absolute string.
+        let matcher = trackingParametersMatcher()
+        guard let query = url.query, matcher.containsTrackingParameters(inQuery: query),
+              let cleanURLString = matcher.removingTrackingParameters(from: url.absoluteString) else {
             return url
         }
 
-        let trackingParams = TrackingLinkSettings(fromConfig: privacyConfig).trackingParameters
+        urlParametersRemoved = true
+        return URL(string: cleanURLString)
+    }
 
-        let preservedParams: [URLQueryItem] = queryParams.filter { param in
-            if trackingParams.contains(where: { $0 == param.name }) {
-                urlParametersRemoved = true
-                return false
-            }
+    private func trackingParametersMatcher() -> TrackingParametersMatcher {
+        let config = privacyConfig
 
-            return true
-        }
+        compiledTrackingParametersLock.lock()
+        defer { compiledTrackingParametersLock.unlock() }
 
-        if urlParametersRemoved {
-            urlsComps.percentEncodedQueryItems = preservedParams.count > 0 ? preservedParams : nil
-            return urlsComps.url
+        if let compiled = compiledTrackingParameters, compiled.configIdentifier == config.identifier {
+            return compiled.matcher
         }
-        return url
+
+        let matcher = TrackingParametersMatcher(parameters: TrackingLinkSettings(fromConfig: config).trackingParameters)
+        compiledTrackingParameters = (config.identifier, matcher)
+        return matcher
     }
 }
@@ -0,0 +1,125 @@
+//
+//  TrackingParametersMatcher.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Tracking parameter list compiled for repeated matching against raw, percent-encoded query strings.
+
+ Names are compared exactly as they appear in the URL, like `URLComponents.percentEncodedQueryItems` would expose them.
+ */
+struct TrackingParametersMatcher {
+
+    private static let questionMark = UInt8(ascii: "?")
+    private static let hash = UInt8(ascii: "#")
+    private static let ampersand = UInt8(ascii: "&")
+    private static let equals = UInt8(ascii: "=")
+
+    private let parameters: Set<Substring>
+
+    // Bit `n` is set when a parameter of UTF-8 length `n` exists, the last bit covers all longer names.
+    private let lengthMask: UInt64
+
+    init(parameters: [String]) {
+        self.parameters = Set(parameters.map { $0[...] })
+        self.lengthMask = parameters.reduce(0) { $0 | Self.lengthBit(for: $1.utf8.count) }
+    }
+
+    var isEmpty: Bool {
+        parameters.isEmpty
+    }
+
+    func matches(_ name: Substring) -> Bool {
+        guard lengthMask & Self.lengthBit(for: name.utf8.count) != 0 else { return false }
+        return parameters.contains(name)
+    }
+
+    /// Checks a raw, percent-encoded query string (without the leading `?`) for tracking parameters without allocating.
+    func containsTrackingParameters(inQuery query: String) -> Bool {
+        let utf8 = query.utf8
+        var itemStart = utf8.startIndex
+
+        while true {
+            let itemEnd = utf8[itemStart...].firstIndex(of: Self.ampersand) ?? utf8.endIndex
+            let nameEnd = utf8[itemStart..<itemEnd].firstIndex(of: Self.equals) ?? itemEnd
+
+            if matches(query[itemStart..<nameEnd]) {
+                return true
+            }
+
+            guard itemEnd < utf8.endIndex else { return false }
+            itemStart = utf8.index(after: itemEnd)
+        }
+    }
+
+    /**
+     Removes tracking parameters from the query of `urlString` in a single pass, preserving order and encoding of remaining items.
+
+     - Returns: Rewritten URL string, or `nil` if the query contains no tracking parameters.
+     */
+    func removingTrackingParameters(from urlString: String) -> String? {
+        let utf8 = urlString.utf8
+        guard let queryMarker = utf8.firstIndex(where: { $0 == Self.questionMark || $0 == Self.hash }),
+              utf8[queryMarker] == Self.questionMark else {
+            return nil
+        }
+
+        let queryStart = utf8.index(after: queryMarker)
+        let queryEnd = utf8[queryStart...].firstIndex(of: Self.hash) ?? utf8.endIndex
+
+        // Output is only allocated once the first tracking parameter is found.
+        var result: String?
+        var hasKeptItems = false
+        var itemStart = queryStart
+
+        while true {
+            let itemEnd = utf8[itemStart..<queryEnd].firstIndex(of: Self.ampersand) ?? queryEnd
+            let nameEnd = utf8[itemStart..<itemEnd].firstIndex(of: Self.equals) ?? itemEnd
+
+            if matches(urlString[itemStart..<nameEnd]) {
+                if result == nil {
+                    var output = String(urlString[..<queryMarker])
+                    output.reserveCapacity(utf8.count)
+                    if itemStart > queryStart {
+                        // Everything before the first match is kept as is.
+                        output += "?"
+                        output += urlString[queryStart..<utf8.index(before: itemStart)]
+                        hasKeptItems = true
+                    }
+                    result = output
+                }
+            } else if result != nil {
+                result! += hasKeptItems ? "&" : "?"
+                result! += urlString[itemStart..<itemEnd]
+                hasKeptItems = true
+            }
+
+            guard itemEnd < queryEnd else { break }
+            itemStart = utf8.index(after: itemEnd)
+        }
+
+        guard var result else { return nil }
+        result += urlString[queryEnd...]
+        return result
+    }
+
+    private static func lengthBit(for length: Int) -> UInt64 {
+        1 << UInt64(min(length, 63))
+    }
+
+}
@@ -35,6 +35,7 @@ public struct AppPrivacyConfiguration: PrivacyConfiguration {
     private let userDefaults: UserDefaults
     private let locale: Locale
     private let installDate: Date?
+    private let domainMatcher: PrivacyConfigurationDomainMatcher
     static let experimentManagerQueue = DispatchQueue(label: "com.experimentManager.queue")
 
     public init(data: PrivacyConfigurationData,
@@ -43,7 +44,8 @@ public struct AppPrivacyConfiguration: PrivacyConfiguration {
                 internalUserDecider: InternalUserDecider,
                 userDefaults: UserDefaults = UserDefaults(),
                 locale: Locale = Locale.current,
-                installDate: Date? = nil) {
+                installDate: Date? = nil,
+                domainMatcher: PrivacyConfigurationDomainMatcher? = nil) {
         self.data = data
         self.identifier = identifier
         self.locallyUnprotected = localProtection
@@ -51,6 +53,7 @@ public struct AppPrivacyConfiguration: PrivacyConfiguration {
         self.userDefaults = userDefaults
         self.locale = locale
         self.installDate = installDate
+        self.domainMatcher = domainMatcher ?? PrivacyConfigurationDomainMatcher(data: data)
     }
 
     public var version: String? {
@@ -286,34 +289,19 @@ public struct AppPrivacyConfiguration: PrivacyConfiguration {
     public func isUserUnprotected(domain: String?) -> Bool {
         guard let domain = domain else { return false }
 
-        return userUnprotectedDomains.contains(domain)
+        return domainMatcher.isUserUnprotected(domain: domain, unprotectedDomains: locallyUnprotected.unprotectedDomains)
     }
 
     public func isTempUnprotected(domain: String?) -> Bool {
-        return isDomain(domain, wildcardMatching: tempUnprotectedDomains)
-    }
+        guard let domain = domain else { return false }
 
-    public func isInExceptionList(domain: String?, forFeature featureKey: PrivacyFeature) -> Bool {
-        return isDomain(domain, wildcardMatching: exceptionsList(forFeature: featureKey))
+        return domainMatcher.isTempUnprotected(domain: domain)
     }
 
-    private func isDomain(_ domain: String?, wildcardMatching domainsList: [String]) -> Bool {
+    public func isInExceptionList(domain: String?, forFeature featureKey: PrivacyFeature) -> Bool {
         guard let domain = domain else { return false }
 
-        let trimmedDomains = domainsList.filter { !$0.trimmingWhitespace().isEmpty }
-
-        // Break domain apart to handle www.*
-        var tempDomain = domain
-        while tempDomain.contains(".") {
-            if trimmedDomains.contains(tempDomain) {
-                return true
-            }
-
-            let comps = tempDomain.split(separator: ".")
-            tempDomain = comps.dropFirst().joined(separator: ".")
-        }
-
-        return false
+        return domainMatcher.isInExceptionList(domain: domain, forFeature: featureKey)
     }
 
     public func settings(for feature: PrivacyFeature) -> PrivacyConfigurationData.PrivacyFeature.FeatureSettings {
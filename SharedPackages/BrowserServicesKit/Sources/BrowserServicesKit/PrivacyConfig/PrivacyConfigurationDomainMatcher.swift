@@ -0,0 +1,109 @@
+//
+//  PrivacyConfigurationDomainMatcher.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Common
+import Foundation
+
+/// Precompiled domain lists of a single privacy configuration revision.
+///
+/// Temporarily unprotected domains and feature exceptions are normalized once and kept in hash sets, so checking a domain
+/// is a walk over its suffixes with no intermediate strings or arrays. Every set is compiled on first use, so creating a matcher
+/// for a configuration that is never queried costs nothing.
+/// User unprotected domains are stored outside of the configuration, so their set is recompiled whenever the store contents change.
+public final class PrivacyConfigurationDomainMatcher {
+
+    private let data: PrivacyConfigurationData
+
+    private let lock = NSLock()
+    private var _tempUnprotectedDomains: Set<Substring>?
+    private var featureExceptions = [PrivacyFeature: Set<Substring>]()
+    private var userUnprotected: (source: Set<String>, domains: Set<Substring>)?
+
+    public init(data: PrivacyConfigurationData) {
+        self.data = data
+    }
+
+    public func isTempUnprotected(domain: String) -> Bool {
+        Self.isDomain(domain, wildcardMatching: tempUnprotectedDomains())
+    }
+
+    public func isInExceptionList(domain: String, forFeature feature: PrivacyFeature) -> Bool {
+        Self.isDomain(domain, wildcardMatching: exceptions(forFeature: feature))
+    }
+
+    /// Exact match against the normalized contents of `unprotectedDomains`.
+    public func isUserUnprotected(domain: String, unprotectedDomains: Set<String>) -> Bool {
+        guard !unprotectedDomains.isEmpty else { return false }
+        return userUnprotectedDomains(from: unprotectedDomains).contains(domain[...])
+    }
+
+    private func tempUnprotectedDomains() -> Set<Substring> {
+        lock.lock(); defer { lock.unlock() }
+        if let tempUnprotectedDomains = _tempUnprotectedDomains {
+            return tempUnprotectedDomains
+        }
+        let tempUnprotectedDomains = Self.compile(data.unprotectedTemporary.map { $0.domain })
+        _tempUnprotectedDomains = tempUnprotectedDomains
+        return tempUnprotectedDomains
+    }
+
+    private func exceptions(forFeature feature: PrivacyFeature) -> Set<Substring> {
+        lock.lock(); defer { lock.unlock() }
+        if let exceptions = featureExceptions[feature] {
+            return exceptions
+        }
+        let exceptions = Self.compile(data.features[feature.rawValue]?.exceptions.map { $0.domain } ?? [])
+        featureExceptions[feature] = exceptions
+        return exceptions
+    }
+
+    private func userUnprotectedDomains(from source: Set<String>) -> Set<Substring> {
+        lock.lock(); defer { lock.unlock() }
+        if let userUnprotected, userUnprotected.source == source {
+            return userUnprotected.domains
+        }
+        let domains = Set(Array(source).normalizedDomainsForContentBlocking().map { $0[...] })
+        userUnprotected = (source, domains)
+        return domains
+    }
+
+    private static func compile(_ domains: [String]) -> Set<Substring> {
+        Set(domains.normalizedDomainsForContentBlocking().lazy
+            .filter { !$0.trimmingWhitespace().isEmpty }
+            .map { $0[...] })
+    }
+
+    /// Matches the domain and each of its parent domains, down to (but excluding) the top level label.
+    private static func isDomain(_ domain: String, wildcardMatching domains: Set<Substring>) -> Bool {
+        guard !domains.isEmpty else { return false }
+
+        var suffix = domain[...]
+        while let dot = suffix.firstIndex(of: ".") {
+            if domains.contains(suffix) {
+                return true
+            }
+            suffix = suffix[suffix.index(after: dot)...]
+            // Empty labels are skipped, like when splitting the domain into components.
+            while suffix.first == "." {
+                suffix = suffix.dropFirst()
+            }
+        }
+        return false
+    }
+
+}
@@ -65,6 +65,7 @@ public class PrivacyConfigurationManager: PrivacyConfigurationManaging {
     }
 
     private var _fetchedConfigData: ConfigurationData?
+    private var _fetchedDomainMatcher: PrivacyConfigurationDomainMatcher?
     private(set) public var fetchedConfigData: ConfigurationData? {
         get {
             lock.lock()
@@ -73,13 +74,16 @@ public class PrivacyConfigurationManager: PrivacyConfigurationManaging {
             return data
         }
         set {
+            let domainMatcher = newValue.map { PrivacyConfigurationDomainMatcher(data: $0.data) }
             lock.lock()
             _fetchedConfigData = newValue
+            _fetchedDomainMatcher = domainMatcher
             lock.unlock()
         }
     }
 
     private var _embeddedConfigData: ConfigurationData!
+    private var _embeddedDomainMatcher: PrivacyConfigurationDomainMatcher?
     private(set) public var embeddedConfigData: ConfigurationData {
         get {
             lock.lock()
@@ -101,10 +105,34 @@ public class PrivacyConfigurationManager: PrivacyConfigurationManaging {
         set {
             lock.lock()
             _embeddedConfigData = newValue
+            _embeddedDomainMatcher = nil
             lock.unlock()
         }
     }
 
+    /// Domain matcher compiled for the revision currently in use, shared by all `privacyConfig` instances of that revision.
+    private var currentConfiguration: (data: ConfigurationData, domainMatcher: PrivacyConfigurationDomainMatcher) {
+        lock.lock()
+        if let fetched = _fetchedConfigData, let domainMatcher = _fetchedDomainMatcher {
+            lock.unlock()
+            return (fetched, domainMatcher)
+        }
+        lock.unlock()
+
+        // Embedded data is loaded lazily, only when there is no fetched config.
+        let embedded = embeddedConfigData
+
+        lock.lock()
+        defer { lock.unlock() }
+
+        if let domainMatcher = _embeddedDomainMatcher {
+            return (embedded, domainMatcher)
+        }
+        let domainMatcher = PrivacyConfigurationDomainMatcher(data: embedded.data)
+        _embeddedDomainMatcher = domainMatcher
+        return (embedded, domainMatcher)
+    }
+
     public init(fetchedETag: String?,
                 fetchedData: Data?,
                 embeddedDataProvider: EmbeddedDataProvider,
@@ -125,21 +153,14 @@ public class PrivacyConfigurationManager: PrivacyConfigurationManaging {
     }
 
     public var privacyConfig: PrivacyConfiguration {
-        if let fetchedData = fetchedConfigData {
-            return AppPrivacyConfiguration(data: fetchedData.data,
-                                           identifier: fetchedData.etag,
-                                           localProtection: localProtection,
-                                           internalUserDecider: internalUserDecider,
-                                           locale: locale,
-                                           installDate: installDate)
-        }
-
-        return AppPrivacyConfiguration(data: embeddedConfigData.data,
-                                       identifier: embeddedConfigData.etag,
+        let configuration = currentConfiguration
+        return AppPrivacyConfiguration(data: configuration.data.data,
+                                       identifier: configuration.data.etag,
                                        localProtection: localProtection,
                                        internalUserDecider: internalUserDecider,
                                        locale: locale,
-                                       installDate: installDate)
+                                       installDate: installDate,
+                                       domainMatcher: configuration.domainMatcher)
     }
 
     public var currentConfig: Data {
@@ -0,0 +1,336 @@
+//
+//  ProtectionDataSnapshot+DataSets.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+// Data set views reference the snapshot, so that it stays mapped for as long as any of them is in use.
+extension ProtectionDataSnapshot {
+
+    public var httpsBloomFilter: HTTPSBloomFilter? {
+        section(.httpsBloomFilter).flatMap { HTTPSBloomFilter(section: $0, snapshot: self) }
+    }
+
+    public var httpsExcludedDomains: StringSet? {
+        section(.httpsExcludedDomains).flatMap { StringSet(section: $0, snapshot: self) }
+    }
+
+    public func maliciousSiteHashPrefixes(threatKind: String) -> HashPrefixes? {
+        section(.maliciousSiteHashPrefixes, name: threatKind).flatMap { HashPrefixes(section: $0, snapshot: self) }
+    }
+
+    public func maliciousSiteFilters(threatKind: String) -> StringMultimap? {
+        section(.maliciousSiteFilters, name: threatKind).flatMap { StringMultimap(section: $0, snapshot: self) }
+    }
+
+    public var trackerData: TrackerDataSet? {
+        section(.trackerData).flatMap { TrackerDataSet(section: $0, snapshot: self) }
+    }
+
+    /// Bloom filter queried in place, using the hashing scheme of `bloom_cpp` that `BloomFilterWrapper` files are built with.
+    public struct HTTPSBloomFilter {
+
+        public let specification: HTTPSBloomFilterSpecification
+        private let bits: UnsafeRawBufferPointer
+        private let bitCount: UInt64
+        private let hashRounds: UInt32
+        private let snapshot: ProtectionDataSnapshot
+
+        init?(section: Section, snapshot: ProtectionDataSnapshot) {
+            guard section.layout == .bloomFilter else { return nil }
+            let bytes = section.bytes
+            bitCount = bytes.readInteger(at: 0, as: UInt64.self)
+            let totalEntries = bytes.readInteger(at: 8, as: UInt64.self)
+            specification = HTTPSBloomFilterSpecification(bitCount: Int(bitCount),
+                                                          errorRate: Double(bitPattern: bytes.readInteger(at: 16, as: UInt64.self)),
+                                                          totalEntries: Int(totalEntries),
+                                                          sha256: String(decoding: bytes[24..<88].prefix { $0 != 0 }, as: UTF8.self))
+            hashRounds = UInt32((log(2.0) * Double(bitCount) / Double(totalEntries)).rounded())
+            bits = UnsafeRawBufferPointer(rebasing: bytes[88...])
+            self.snapshot = snapshot
+        }
+
+        public func contains(_ entry: String) -> Bool {
+            var hash1: UInt32 = 5381 // djb2
+            var hash2: UInt32 = 0 // sdbm
+            for byte in entry.utf8 {
+                // bloom_cpp hashes `char` values, which are signed on Apple platforms.
+                let character = UInt32(bitPattern: Int32(Int8(bitPattern: byte)))
+                hash1 = (hash1 << 5) &+ hash1 &+ character
+                hash2 = character &+ (hash2 << 6) &+ (hash2 << 16) &- hash2
+            }
+
+            for round in 0..<hashRounds {
+                let hash = switch round {
+                case 0: hash1
+                case 1: hash2
+                default: hash1 &+ round &* hash2 &+ (round ^ 2)
+                }
+                let index = Int(UInt64(hash) % bitCount)
+                guard bits[index >> 3] & (1 << (index & 7)) != 0 else { return false }
+            }
+            return true
+        }
+
+    }
+
+    /// Set of strings, binary searched in place
+    public struct StringSet {
+
+        public let revision: Int
+        let table: SortedStrings
+        private let snapshot: ProtectionDataSnapshot
+
+        init?(section: Section, snapshot: ProtectionDataSnapshot) {
+            guard section.layout == .sortedStrings else { return nil }
+            revision = section.revision
+            table = SortedStrings(bytes: section.bytes)
+            self.snapshot = snapshot
+        }
+
+        public var count: Int { table.count }
+
+        public func contains(_ string: String) -> Bool {
+            var string = string
+            return string.withUTF8 { table.index(of: UnsafeRawBufferPointer($0)) != nil }
+        }
+
+        public var allStrings: [String] {
+            (0..<table.count).map { String(decoding: table[$0], as: UTF8.self) }
+        }
+
+    }
+
+    /// Hash prefixes, stored as numbers when all of them are 8 hex digits
+    public struct HashPrefixes {
+
+        public let revision: Int
+        private let storage: Storage
+        private let snapshot: ProtectionDataSnapshot
+
+        private enum Storage {
+            case numbers(UnsafeRawBufferPointer)
+            case strings(SortedStrings)
+        }
+
+        init?(section: Section, snapshot: ProtectionDataSnapshot) {
+            switch section.layout {
+            case .sortedHexPrefixes:
+                let count = Int(section.bytes.readInteger(at: 0, as: UInt32.self))
+                storage = .numbers(UnsafeRawBufferPointer(rebasing: section.bytes[8..<(8 + count * 4)]))
+            case .sortedStrings:
+                storage = .strings(SortedStrings(bytes: section.bytes))
+            default:
+                return nil
+            }
+            revision = section.revision
+            self.snapshot = snapshot
+        }
+
+        public var count: Int {
+            switch storage {
+            case .numbers(let values): values.count / 4
+            case .strings(let table): table.count
+            }
+        }
+
+        public func contains(_ prefix: String) -> Bool {
+            switch storage {
+            case .numbers(let values):
+                guard let value = HexPrefix.value(of: prefix) else { return false }
+                let index = lowerBound(count: values.count / 4) { values.readInteger(at: $0 * 4, as: UInt32.self) < value }
+                return index < values.count / 4 && values.readInteger(at: index * 4, as: UInt32.self) == value
+            case .strings(let table):
+                var prefix = prefix
+                return prefix.withUTF8 { table.index(of: UnsafeRawBufferPointer($0)) != nil }
+            }
+        }
+
+        public var allPrefixes: [String] {
+            switch storage {
+            case .numbers(let values):
+                (0..<(values.count / 4)).map { HexPrefix.string(from: values.readInteger(at: $0 * 4, as: UInt32.self)) }
+            case .strings(let table):
+                (0..<table.count).map { String(decoding: table[$0], as: UTF8.self) }
+            }
+        }
+
+    }
+
+    /// Key-value pairs sorted by key, e.g. malicious site filter regexes by host hash
+    public struct StringMultimap {
+
+        public let revision: Int
+        private let bytes: UnsafeRawBufferPointer
+        private let pool: UnsafeRawBufferPointer
+        private let snapshot: ProtectionDataSnapshot
+
+        init?(section: Section, snapshot: ProtectionDataSnapshot) {
+            guard section.layout == .sortedStringPairs else { return nil }
+            revision = section.revision
+            bytes = section.bytes
+            let poolStart = 8 + Int(bytes.readInteger(at: 0, as: UInt32.self)) * 16
+            pool = UnsafeRawBufferPointer(rebasing: bytes[poolStart..<(poolStart + Int(bytes.readInteger(at: 4, as: UInt32.self)))])
+            self.snapshot = snapshot
+        }
+
+        /// Number of pairs
+        public var count: Int {
+            Int(bytes.readInteger(at: 0, as: UInt32.self))
+        }
+
+        /// Number of distinct keys
+        public var keyCount: Int {
+            (0..<count).reduce(0) { result, index in
+                index > 0 && compare(key(at: index - 1), key(at: index)) == 0 ? result : result + 1
+            }
+        }
+
+        public func values(forKey key: String) -> [String] {
+            var key = key
+            return key.withUTF8 { key in
+                let key = UnsafeRawBufferPointer(key)
+                var index = lowerBound(count: count) { compare(self.key(at: $0), key) < 0 }
+                var values = [String]()
+                while index < count, compare(self.key(at: index), key) == 0 {
+                    values.append(String(decoding: value(at: index), as: UTF8.self))
+                    index += 1
+                }
+                return values
+            }
+        }
+
+        public var allPairs: [(key: String, value: String)] {
+            (0..<count).map { (String(decoding: key(at: $0), as: UTF8.self), String(decoding: value(at: $0), as: UTF8.self)) }
+        }
+
+        private func key(at index: Int) -> UnsafeRawBufferPointer {
+            string(atRecordOffset: 8 + index * 16)
+        }
+
+        private func value(at index: Int) -> UnsafeRawBufferPointer {
+            string(atRecordOffset: 8 + index * 16 + 8)
+        }
+
+        private func string(atRecordOffset recordOffset: Int) -> UnsafeRawBufferPointer {
+            let offset = Int(bytes.readInteger(at: recordOffset, as: UInt32.self))
+            let length = Int(bytes.readInteger(at: recordOffset + 4, as: UInt32.self))
+            return UnsafeRawBufferPointer(rebasing: pool[offset..<(offset + length)])
+        }
+
+    }
+
+    /// Tracker Data Set JSON with its ETag. `data` references the mapped file without copying it,
+    /// but it's not queried in place: every process still decodes the JSON into its own `TrackerData`.
+    public struct TrackerDataSet {
+
+        public let etag: String
+        public let data: Data
+
+        init?(section: Section, snapshot: ProtectionDataSnapshot) {
+            guard section.layout == .namedBlob else { return nil }
+            let bytes = section.bytes
+            let nameLength = Int(bytes.readInteger(at: 0, as: UInt32.self))
+            let dataStart = 16 + (nameLength + 7) / 8 * 8
+            let dataLength = Int(bytes.readInteger(at: 8, as: UInt64.self))
+            etag = String(decoding: bytes[16..<(16 + nameLength)], as: UTF8.self)
+            data = Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: bytes.baseAddress! + dataStart),
+                        count: dataLength,
+                        deallocator: .custom { _, _ in withExtendedLifetime(snapshot) {} })
+        }
+
+    }
+
+}
+
+// MARK: - Lookup helpers
+
+struct SortedStrings {
+
+    let bytes: UnsafeRawBufferPointer
+
+    var count: Int {
+        Int(bytes.readInteger(at: 0, as: UInt32.self))
+    }
+
+    subscript(index: Int) -> UnsafeRawBufferPointer {
+        let poolStart = 8 + (count + 1) * 4
+        let start = Int(bytes.readInteger(at: 8 + index * 4, as: UInt32.self))
+        let end = Int(bytes.readInteger(at: 8 + (index + 1) * 4, as: UInt32.self))
+        return UnsafeRawBufferPointer(rebasing: bytes[(poolStart + start)..<(poolStart + end)])
+    }
+
+    func index(of string: UnsafeRawBufferPointer) -> Int? {
+        let index = lowerBound(count: count) { compare(self[$0], string) < 0 }
+        return index < count && compare(self[index], string) == 0 ? index : nil
+    }
+
+}
+
+enum HexPrefix {
+
+    static let length = 8
+
+    /// Value of an 8 digit lowercase hex string
+    static func value(of string: String) -> UInt32? {
+        guard string.utf8.count == length else { return nil }
+        var value: UInt32 = 0
+        for byte in string.utf8 {
+            let digit: UInt8
+            switch byte {
+            case UInt8(ascii: "0")...UInt8(ascii: "9"): digit = byte - UInt8(ascii: "0")
+            case UInt8(ascii: "a")...UInt8(ascii: "f"): digit = byte - UInt8(ascii: "a") + 10
+            default: return nil
+            }
+            value = value << 4 | UInt32(digit)
+        }
+        return value
+    }
+
+    static func string(from value: UInt32) -> String {
+        let digits = Array("0123456789abcdef".utf8)
+        return String(decoding: (0..<length).reversed().map { digits[Int(value >> ($0 * 4)) & 0xF] }, as: UTF8.self)
+    }
+
+}
+
+/// Index of the first element for which `isLess` is false
+@inline(__always)
+private func lowerBound(count: Int, isLess: (Int) -> Bool) -> Int {
+    var low = 0
+    var high = count
+    while low < high {
+        let middle = (low + high) / 2
+        if isLess(middle) {
+            low = middle + 1
+        } else {
+            high = middle
+        }
+    }
+    return low
+}
+
+/// Lexicographic comparison of bytes
+@inline(__always)
+private func compare(_ lhs: UnsafeRawBufferPointer, _ rhs: UnsafeRawBufferPointer) -> Int {
+    let length = min(lhs.count, rhs.count)
+    if length > 0, let lhsBase = lhs.baseAddress, let rhsBase = rhs.baseAddress {
+        let result = memcmp(lhsBase, rhsBase, length)
+        if result != 0 { return Int(result) }
+    }
+    return lhs.count - rhs.count
+}
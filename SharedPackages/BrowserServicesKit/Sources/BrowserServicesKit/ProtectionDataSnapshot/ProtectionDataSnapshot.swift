@@ -0,0 +1,235 @@
+//
+//  ProtectionDataSnapshot.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ * Read-only, memory-mapped snapshot of the data sets used for protections: the HTTPS upgrade Bloom filter and
+ * excluded domains, malicious site protection hash prefixes and filters, and the Tracker Data Set.
+ *
+ * A snapshot file is immutable. The process updating the data publishes a new generation of the file
+ * (see `ProtectionDataSnapshotBuilder`), and every process maps it with `ProtectionDataSnapshotStore`.
+ * HTTPS upgrade and malicious site protection data sets are stored in layouts that are queried in place, so their
+ * pages are shared by all the processes mapping the file instead of being parsed into each process' heap.
+ * The Tracker Data Set is stored as its JSON blob, which saves reading the file but is still decoded by each process.
+ *
+ * File layout (all integers are little-endian, sections are 8-byte aligned):
+ * ```
+ * header:        magic "DDGPDSNP", format version: u32, section count: u32, generation: u64, file length: u64
+ * section table: section count × { kind: u16, layout: u16, reserved: u32, offset: u64, length: u64, revision: i64, name: 16 bytes }
+ * sections
+ * ```
+ */
+public final class ProtectionDataSnapshot {
+
+    public enum Error: Swift.Error, Equatable {
+        case cannotOpenFile(errno: Int32)
+        case cannotMapFile(errno: Int32)
+        case invalidHeader
+        case unsupportedFormatVersion(UInt32)
+        case invalidSection(index: Int)
+    }
+
+    public static let formatVersion: UInt32 = 1
+
+    public let url: URL
+    /// Increases with every published snapshot
+    public let generation: UInt64
+
+    let sections: [Section]
+    private let mapping: UnsafeRawBufferPointer
+
+    public init(contentsOf url: URL) throws {
+        let fd = open(url.path, O_RDONLY | O_CLOEXEC)
+        guard fd >= 0 else { throw Error.cannotOpenFile(errno: errno) }
+        defer { close(fd) }
+
+        var fileStat = stat()
+        guard fstat(fd, &fileStat) == 0 else { throw Error.cannotOpenFile(errno: errno) }
+        let length = Int(fileStat.st_size)
+        guard length >= Layout.headerLength else { throw Error.invalidHeader }
+
+        // The file is replaced rather than modified when a new generation is published, so the mapping stays valid.
+        guard let address = mmap(nil, length, PROT_READ, MAP_SHARED, fd, 0), address != MAP_FAILED else {
+            throw Error.cannotMapFile(errno: errno)
+        }
+        let mapping = UnsafeRawBufferPointer(start: address, count: length)
+
+        do {
+            let header = try Self.readHeader(mapping)
+            self.generation = header.generation
+            self.sections = try Self.readSections(mapping, count: header.sectionCount)
+        } catch {
+            munmap(address, length)
+            throw error
+        }
+        self.url = url
+        self.mapping = mapping
+    }
+
+    deinit {
+        munmap(UnsafeMutableRawPointer(mutating: mapping.baseAddress), mapping.count)
+    }
+
+    func section(_ kind: Section.Kind, name: String = "") -> Section? {
+        sections.first { $0.kind == kind && $0.name == name }
+    }
+
+    // MARK: - Reading
+
+    private static func readHeader(_ mapping: UnsafeRawBufferPointer) throws -> (sectionCount: Int, generation: UInt64) {
+        guard mapping.starts(with: Layout.magic) else { throw Error.invalidHeader }
+        let formatVersion = mapping.readInteger(at: 8, as: UInt32.self)
+        guard formatVersion == Self.formatVersion else { throw Error.unsupportedFormatVersion(formatVersion) }
+
+        let sectionCount = Int(mapping.readInteger(at: 12, as: UInt32.self))
+        let fileLength = mapping.readInteger(at: 24, as: UInt64.self)
+        // A shorter file was truncated, e.g. by running out of disk space while being copied.
+        guard fileLength == mapping.count,
+              Layout.headerLength + sectionCount * Layout.sectionEntryLength <= mapping.count else { throw Error.invalidHeader }
+
+        return (sectionCount, mapping.readInteger(at: 16, as: UInt64.self))
+    }
+
+    private static func readSections(_ mapping: UnsafeRawBufferPointer, count: Int) throws -> [Section] {
+        try (0..<count).compactMap { index in
+            let entry = Layout.headerLength + index * Layout.sectionEntryLength
+            let offset = mapping.readInteger(at: entry + 8, as: UInt64.self)
+            let length = mapping.readInteger(at: entry + 16, as: UInt64.self)
+            guard offset % 8 == 0, offset <= mapping.count, length <= UInt64(mapping.count) - offset else {
+                throw Error.invalidSection(index: index)
+            }
+
+            // Sections of kinds added in later revisions of the format are skipped.
+            guard let kind = Section.Kind(rawValue: mapping.readInteger(at: entry, as: UInt16.self)),
+                  let layout = Section.Layout(rawValue: mapping.readInteger(at: entry + 2, as: UInt16.self)) else { return nil }
+
+            let nameBytes = UnsafeRawBufferPointer(rebasing: mapping[(entry + 32)..<(entry + 32 + Layout.sectionNameLength)])
+            let section = Section(kind: kind,
+                                  layout: layout,
+                                  revision: Int(mapping.readInteger(at: entry + 24, as: Int64.self)),
+                                  name: String(decoding: nameBytes.prefix { $0 != 0 }, as: UTF8.self),
+                                  bytes: UnsafeRawBufferPointer(rebasing: mapping[Int(offset)..<Int(offset + length)]))
+            guard section.isValid else { throw Error.invalidSection(index: index) }
+            return section
+        }
+    }
+
+}
+
+extension ProtectionDataSnapshot {
+
+    enum Layout {
+        static let magic = Array("DDGPDSNP".utf8)
+        static let headerLength = 32
+        static let sectionEntryLength = 48
+        static let sectionNameLength = 16
+    }
+
+    struct Section {
+
+        enum Kind: UInt16 {
+            case httpsBloomFilter = 1
+            case httpsExcludedDomains = 2
+            case maliciousSiteHashPrefixes = 3
+            case maliciousSiteFilters = 4
+            case trackerData = 5
+        }
+
+        enum Layout: UInt16 {
+            /// bit count: u64, total entries: u64, error rate: f64, sha256: 64 bytes, bits
+            case bloomFilter = 1
+            /// count: u32, pool length: u32, (count + 1) × string offset: u32, string pool; sorted by UTF-8 bytes
+            case sortedStrings = 2
+            /// count: u32, reserved: u32, count × value: u32; sorted 8 digit hex strings, as numbers
+            case sortedHexPrefixes = 3
+            /// count: u32, pool length: u32, count × { key offset: u32, key length: u32, value offset: u32, value length: u32 }, string pool;
+            /// sorted by key UTF-8 bytes
+            case sortedStringPairs = 4
+            /// name length: u32, reserved: u32, data length: u64, name, padding to 8 bytes, data
+            case namedBlob = 5
+        }
+
+        let kind: Kind
+        let layout: Layout
+        let revision: Int
+        let name: String
+        let bytes: UnsafeRawBufferPointer
+
+        /// Checks that all offsets stored in the section are within its bounds, so lookups don't need to.
+        var isValid: Bool {
+            switch layout {
+            case .bloomFilter:
+                guard bytes.count >= 88 else { return false }
+                let bitCount = bytes.readInteger(at: 0, as: UInt64.self)
+                let totalEntries = bytes.readInteger(at: 8, as: UInt64.self)
+                return bitCount > 0 && totalEntries > 0 && bitCount <= UInt64(bytes.count - 88) * 8
+
+            case .sortedStrings:
+                guard bytes.count >= 8 else { return false }
+                let count = Int(bytes.readInteger(at: 0, as: UInt32.self))
+                let poolLength = Int(bytes.readInteger(at: 4, as: UInt32.self))
+                let poolStart = 8 + (count + 1) * 4
+                guard poolStart + poolLength <= bytes.count else { return false }
+                var previous: UInt32 = 0
+                for index in 0...count {
+                    let offset = bytes.readInteger(at: 8 + index * 4, as: UInt32.self)
+                    guard offset >= previous, offset <= poolLength else { return false }
+                    previous = offset
+                }
+                return true
+
+            case .sortedHexPrefixes:
+                guard bytes.count >= 8 else { return false }
+                return 8 + Int(bytes.readInteger(at: 0, as: UInt32.self)) * 4 <= bytes.count
+
+            case .sortedStringPairs:
+                guard bytes.count >= 8 else { return false }
+                let count = Int(bytes.readInteger(at: 0, as: UInt32.self))
+                let poolLength = UInt64(bytes.readInteger(at: 4, as: UInt32.self))
+                guard 8 + count * 16 + Int(poolLength) <= bytes.count else { return false }
+                for index in 0..<count {
+                    let record = 8 + index * 16
+                    for field in stride(from: 0, to: 16, by: 8) {
+                        let offset = UInt64(bytes.readInteger(at: record + field, as: UInt32.self))
+                        let length = UInt64(bytes.readInteger(at: record + field + 4, as: UInt32.self))
+                        guard offset + length <= poolLength else { return false }
+                    }
+                }
+                return true
+
+            case .namedBlob:
+                guard bytes.count >= 16 else { return false }
+                let nameLength = UInt64(bytes.readInteger(at: 0, as: UInt32.self))
+                let dataStart = 16 + (nameLength + 7) / 8 * 8
+                return dataStart <= UInt64(bytes.count) && bytes.readInteger(at: 8, as: UInt64.self) <= UInt64(bytes.count) - dataStart
+            }
+        }
+
+    }
+
+}
+
+extension UnsafeRawBufferPointer {
+
+    @inline(__always)
+    func readInteger<T: FixedWidthInteger>(at offset: Int, as type: T.Type) -> T {
+        T(littleEndian: loadUnaligned(fromByteOffset: offset, as: T.self))
+    }
+
+}
@@ -0,0 +1,289 @@
+//
+//  ProtectionDataSnapshotBuilder.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Assembles a `ProtectionDataSnapshot` file, to be published by the process that updates protection data.
+///
+/// A builder only replaces the sections added to it: when published, the other sections are carried over
+/// from the generation being replaced, so processes updating different data sets don't drop each other's sections.
+public struct ProtectionDataSnapshotBuilder {
+
+    public enum Error: Swift.Error, Equatable {
+        case invalidBloomFilter
+        case invalidSectionName(String)
+        case sectionTooLarge
+        case cannotPublish(errno: Int32)
+    }
+
+    private typealias Section = ProtectionDataSnapshot.Section
+
+    private struct SectionID: Hashable {
+        let kind: Section.Kind
+        let name: String
+    }
+
+    private var sections = [(kind: Section.Kind, layout: Section.Layout, revision: Int, name: String, payload: Data)]()
+    /// Sections added to this builder, as opposed to copied from a snapshot
+    private var addedSections = Set<SectionID>()
+
+    public init() {}
+
+    /// Starts with the sections of `snapshot`, to be replaced by the ones added later
+    public init(copying snapshot: ProtectionDataSnapshot) {
+        sections = snapshot.sections.map { ($0.kind, $0.layout, $0.revision, $0.name, Data($0.bytes)) }
+    }
+
+    /// Whether no sections were added to this builder
+    public var isEmpty: Bool {
+        addedSections.isEmpty
+    }
+
+    public mutating func addHTTPSBloomFilter(specification: HTTPSBloomFilterSpecification, data: Data) throws {
+        guard specification.bitCount > 0, specification.totalEntries > 0, specification.bitCount <= data.count * 8 else {
+            throw Error.invalidBloomFilter
+        }
+        var payload = Data(capacity: 88 + data.count)
+        payload.appendInteger(UInt64(specification.bitCount))
+        payload.appendInteger(UInt64(specification.totalEntries))
+        payload.appendInteger(specification.errorRate.bitPattern)
+        payload.append(contentsOf: specification.sha256.utf8.prefix(64))
+        payload.append(Data(count: 88 - payload.count))
+        payload.append(data)
+        try add(.httpsBloomFilter, layout: .bloomFilter, payload: payload)
+    }
+
+    public mutating func addHTTPSExcludedDomains(_ domains: some Sequence<String>) throws {
+        try add(.httpsExcludedDomains, layout: .sortedStrings, payload: Self.sortedStrings(domains.map { $0.lowercased() }))
+    }
+
+    public mutating func addMaliciousSiteHashPrefixes(_ prefixes: some Sequence<String>, revision: Int, threatKind: String) throws {
+        let prefixes = Set(prefixes)
+        let values = prefixes.compactMap(HexPrefix.value(of:))
+        guard values.count == prefixes.count else {
+            // Prefixes that are not 8 hex digits can't be stored as numbers.
+            try add(.maliciousSiteHashPrefixes, layout: .sortedStrings, revision: revision, name: threatKind, payload: Self.sortedStrings(prefixes))
+            return
+        }
+
+        var payload = Data(capacity: 8 + values.count * 4)
+        payload.appendInteger(UInt32(values.count))
+        payload.appendInteger(UInt32(0))
+        for value in values.sorted() {
+            payload.appendInteger(value)
+        }
+        try add(.maliciousSiteHashPrefixes, layout: .sortedHexPrefixes, revision: revision, name: threatKind, payload: payload)
+    }
+
+    public mutating func addMaliciousSiteFilters(_ filters: some Sequence<(hash: String, regex: String)>, revision: Int, threatKind: String) throws {
+        var pool = StringPool()
+        var records = [(key: String, keyRange: Range<UInt32>, valueRange: Range<UInt32>)]()
+        for filter in filters {
+            records.append((filter.hash, try pool.add(filter.hash), try pool.add(filter.regex)))
+        }
+        records.sort { $0.key.utf8.lexicographicallyPrecedes($1.key.utf8) }
+
+        var payload = Data(capacity: 8 + records.count * 16 + pool.bytes.count)
+        payload.appendInteger(UInt32(records.count))
+        payload.appendInteger(pool.length)
+        for record in records {
+            for range in [record.keyRange, record.valueRange] {
+                payload.appendInteger(range.lowerBound)
+                payload.appendInteger(UInt32(range.count))
+            }
+        }
+        payload.append(pool.bytes)
+        try add(.maliciousSiteFilters, layout: .sortedStringPairs, revision: revision, name: threatKind, payload: payload)
+    }
+
+    public mutating func addTrackerData(_ data: Data, etag: String) throws {
+        var payload = Data(capacity: 16 + etag.utf8.count + 8 + data.count)
+        payload.appendInteger(UInt32(etag.utf8.count))
+        payload.appendInteger(UInt32(0))
+        payload.appendInteger(UInt64(data.count))
+        payload.append(contentsOf: etag.utf8)
+        payload.appendPadding()
+        payload.append(data)
+        try add(.trackerData, layout: .namedBlob, payload: payload)
+    }
+
+    /// Snapshot file contents
+    public func makeData(generation: UInt64) -> Data {
+        let tableLength = ProtectionDataSnapshot.Layout.headerLength + sections.count * ProtectionDataSnapshot.Layout.sectionEntryLength
+        var offsets = [Int]()
+        var fileLength = tableLength
+        for section in sections {
+            offsets.append(fileLength)
+            fileLength += (section.payload.count + 7) / 8 * 8
+        }
+
+        var data = Data(capacity: fileLength)
+        data.append(contentsOf: ProtectionDataSnapshot.Layout.magic)
+        data.appendInteger(ProtectionDataSnapshot.formatVersion)
+        data.appendInteger(UInt32(sections.count))
+        data.appendInteger(generation)
+        data.appendInteger(UInt64(fileLength))
+
+        for (section, offset) in zip(sections, offsets) {
+            data.appendInteger(section.kind.rawValue)
+            data.appendInteger(section.layout.rawValue)
+            data.appendInteger(UInt32(0))
+            data.appendInteger(UInt64(offset))
+            data.appendInteger(UInt64(section.payload.count))
+            data.appendInteger(Int64(section.revision))
+            let name = Array(section.name.utf8)
+            data.append(contentsOf: name + [UInt8](repeating: 0, count: ProtectionDataSnapshot.Layout.sectionNameLength - name.count))
+        }
+        for section in sections {
+            data.append(section.payload)
+            data.appendPadding()
+        }
+        assert(data.count == fileLength)
+        return data
+    }
+
+    /**
+     * Atomically replaces the snapshot at `url` with the next generation and notifies processes observing it.
+     *
+     * The new file is renamed over the previous one, so processes that still have the previous generation mapped
+     * keep reading it until they swap to the new one. Publishing from several processes is serialized with a lock file.
+     * Sections that were not added to this builder are taken from the previous generation when it can be read.
+     * - Returns: generation of the published snapshot
+     */
+    @discardableResult
+    public func publish(to url: URL, notificationName: String = ProtectionDataSnapshotStore.defaultNotificationName) throws -> UInt64 {
+        let directory = url.deletingLastPathComponent()
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        let lockFile = open(url.path + ".lock", O_RDWR | O_CREAT | O_CLOEXEC, 0o644)
+        guard lockFile >= 0 else { throw Error.cannotPublish(errno: errno) }
+        defer { close(lockFile) }
+        guard flock(lockFile, LOCK_EX) == 0 else { throw Error.cannotPublish(errno: errno) }
+        defer { flock(lockFile, LOCK_UN) }
+
+        let previous = try? ProtectionDataSnapshot(contentsOf: url)
+        let generation = (previous?.generation ?? 0) + 1
+        let temporaryURL = directory.appendingPathComponent(".\(url.lastPathComponent).\(UUID().uuidString)")
+        do {
+            try Self.write(merged(into: previous).makeData(generation: generation), to: temporaryURL)
+            guard rename(temporaryURL.path, url.path) == 0 else { throw Error.cannotPublish(errno: errno) }
+        } catch {
+            unlink(temporaryURL.path)
+            throw error
+        }
+
+        CFNotificationCenterPostNotification(CFNotificationCenterGetDarwinNotifyCenter(),
+                                             CFNotificationName(rawValue: notificationName as CFString),
+                                             nil, nil, true)
+        return generation
+    }
+
+    // MARK: - Private
+
+    /// Sections added to this builder, with the other sections of `previous`
+    private func merged(into previous: ProtectionDataSnapshot?) -> ProtectionDataSnapshotBuilder {
+        guard let previous else { return self }
+        var builder = ProtectionDataSnapshotBuilder(copying: previous)
+        builder.sections.removeAll { addedSections.contains(SectionID(kind: $0.kind, name: $0.name)) }
+        builder.sections += sections.filter { addedSections.contains(SectionID(kind: $0.kind, name: $0.name)) }
+        return builder
+    }
+
+    private mutating func add(_ kind: Section.Kind, layout: Section.Layout, revision: Int = 0, name: String = "", payload: Data) throws {
+        guard name.utf8.count <= ProtectionDataSnapshot.Layout.sectionNameLength else { throw Error.invalidSectionName(name) }
+        sections.removeAll { $0.kind == kind && $0.name == name }
+        sections.append((kind, layout, revision, name, payload))
+        addedSections.insert(SectionID(kind: kind, name: name))
+    }
+
+    private static func sortedStrings(_ strings: some Sequence<String>) throws -> Data {
+        let strings = Set(strings).sorted { $0.utf8.lexicographicallyPrecedes($1.utf8) }
+        var pool = StringPool()
+        var offsets = [UInt32]()
+        for string in strings {
+            offsets.append(try pool.add(string).lowerBound)
+        }
+        offsets.append(pool.length)
+
+        var payload = Data(capacity: 8 + offsets.count * 4 + pool.bytes.count)
+        payload.appendInteger(UInt32(strings.count))
+        payload.appendInteger(pool.length)
+        for offset in offsets {
+            payload.appendInteger(offset)
+        }
+        payload.append(pool.bytes)
+        return payload
+    }
+
+    /// Writes and flushes the file, so that it's complete on disk before being renamed into place.
+    private static func write(_ data: Data, to url: URL) throws {
+        let file = open(url.path, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0o644)
+        guard file >= 0 else { throw Error.cannotPublish(errno: errno) }
+        defer { close(file) }
+
+        try data.withUnsafeBytes { buffer in
+            var written = 0
+            while written < buffer.count {
+                let result = Darwin.write(file, buffer.baseAddress! + written, buffer.count - written)
+                guard result >= 0 else {
+                    if errno == EINTR { continue }
+                    throw Error.cannotPublish(errno: errno)
+                }
+                written += result
+            }
+        }
+        guard fsync(file) == 0 else { throw Error.cannotPublish(errno: errno) }
+    }
+
+}
+
+/// Deduplicated UTF-8 strings addressed by byte ranges
+private struct StringPool {
+
+    private(set) var bytes = Data()
+    private var ranges = [String: Range<UInt32>]()
+
+    mutating func add(_ string: String) throws -> Range<UInt32> {
+        if let range = ranges[string] {
+            return range
+        }
+        guard bytes.count + string.utf8.count <= UInt32.max else { throw ProtectionDataSnapshotBuilder.Error.sectionTooLarge }
+        let range = UInt32(bytes.count)..<UInt32(bytes.count + string.utf8.count)
+        bytes.append(contentsOf: string.utf8)
+        ranges[string] = range
+        return range
+    }
+
+    var length: UInt32 {
+        UInt32(bytes.count)
+    }
+
+}
+
+private extension Data {
+
+    mutating func appendInteger<T: FixedWidthInteger>(_ value: T) {
+        Swift.withUnsafeBytes(of: value.littleEndian) { append(contentsOf: $0) }
+    }
+
+    /// Pads to a multiple of 8 bytes
+    mutating func appendPadding() {
+        append(Data(count: (8 - count % 8) % 8))
+    }
+
+}
@@ -0,0 +1,109 @@
+//
+//  ProtectionDataSnapshotStore.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Combine
+import Foundation
+import os.log
+
+/**
+ * Keeps the latest generation of a `ProtectionDataSnapshot` file mapped, and swaps to a new generation
+ * when any process publishes it with `ProtectionDataSnapshotBuilder.publish(to:notificationName:)`.
+ *
+ * Use a file in an app group container to share the data between the app and its extensions.
+ */
+public final class ProtectionDataSnapshotStore {
+
+    public static let defaultNotificationName = "com.duckduckgo.protection-data-snapshot.published"
+
+    public let url: URL
+    public let notificationName: String
+    private let lock = NSLock()
+    private var _snapshot: ProtectionDataSnapshot?
+    private let snapshotSubject = PassthroughSubject<ProtectionDataSnapshot, Never>()
+
+    /// Latest mapped generation. Data sets obtained from it stay valid after a newer generation is swapped in.
+    public var snapshot: ProtectionDataSnapshot? {
+        lock.lock(); defer { lock.unlock() }
+        return _snapshot
+    }
+
+    /// Publishes every newly mapped generation
+    public var snapshotPublisher: AnyPublisher<ProtectionDataSnapshot, Never> {
+        snapshotSubject.eraseToAnyPublisher()
+    }
+
+    public init(url: URL, notificationName: String = ProtectionDataSnapshotStore.defaultNotificationName) {
+        self.url = url
+        self.notificationName = notificationName
+        reload()
+
+        let callback: CFNotificationCallback = { _, observer, _, _, _ in
+            guard let observer else { return }
+            Unmanaged<ProtectionDataSnapshotStore>.fromOpaque(observer).takeUnretainedValue().reload()
+        }
+        CFNotificationCenterAddObserver(CFNotificationCenterGetDarwinNotifyCenter(),
+                                        Unmanaged.passUnretained(self).toOpaque(),
+                                        callback,
+                                        notificationName as CFString,
+                                        nil, .deliverImmediately)
+    }
+
+    deinit {
+        CFNotificationCenterRemoveObserver(CFNotificationCenterGetDarwinNotifyCenter(),
+                                           Unmanaged.passUnretained(self).toOpaque(),
+                                           CFNotificationName(rawValue: notificationName as CFString),
+                                           nil)
+    }
+
+    /// Publishes the sections added to `builder` as the next generation and swaps to it.
+    /// - Returns: the published snapshot
+    @discardableResult
+    public func publish(_ builder: ProtectionDataSnapshotBuilder) throws -> ProtectionDataSnapshot? {
+        try builder.publish(to: url, notificationName: notificationName)
+        return reload()
+    }
+
+    /// Maps the snapshot file if it holds a different generation than the current one.
+    /// - Returns: the current snapshot
+    @discardableResult
+    public func reload() -> ProtectionDataSnapshot? {
+        let snapshot: ProtectionDataSnapshot
+        do {
+            snapshot = try ProtectionDataSnapshot(contentsOf: url)
+        } catch ProtectionDataSnapshot.Error.cannotOpenFile(errno: ENOENT) {
+            return self.snapshot
+        } catch {
+            Logger.protectionDataSnapshot.error("Failed to map \(self.url.path, privacy: .public): \(String(describing: error), privacy: .public)")
+            return self.snapshot
+        }
+
+        lock.lock()
+        // The file is only ever replaced by a newer generation, so a different generation is a newer one.
+        guard snapshot.generation != _snapshot?.generation else {
+            defer { lock.unlock() }
+            return _snapshot
+        }
+        _snapshot = snapshot
+        lock.unlock()
+
+        Logger.protectionDataSnapshot.log("Mapped generation \(snapshot.generation) of \(self.url.lastPathComponent, privacy: .public)")
+        snapshotSubject.send(snapshot)
+        return snapshot
+    }
+
+}
@@ -66,7 +66,7 @@ public class ReferrerTrimming {
         state = .idle
     }
 
-    func getTrimmedReferrer(originUrl: URL, destUrl: URL, referrerUrl: URL?, trackerData: TrackerData) -> String? {
+    func getTrimmedReferrer(originUrl: URL, destUrl: URL, referrerUrl: URL?, trackerDataIndex: TrackerDataIndex) -> String? {
         func isSameEntity(a: Entity?, b: Entity?) -> Bool {
             if a == nil && b == nil {
                 return !originUrl.isThirdParty(to: destUrl, tld: tld)
@@ -92,15 +92,15 @@ public class ReferrerTrimming {
             return nil
         }
 
-        let referEntity = trackerData.findEntity(forHost: originHost)
-        let destEntity = trackerData.findEntity(forHost: destHost)
+        let referEntity = trackerDataIndex.findEntity(forHost: originHost)
+        let destEntity = trackerDataIndex.findEntity(forHost: destHost)
 
         var newReferrer: String?
         if !isSameEntity(a: referEntity, b: destEntity) {
             newReferrer = "\(referrerScheme)://\(referrerHost)/"
         }
 
-        if let tracker = trackerData.findTracker(forUrl: destUrl.absoluteString),
+        if let tracker = destUrl.host.flatMap(trackerDataIndex.findTracker(forHost:)),
            tracker.defaultAction == .block,
            !isSameEntity(a: referEntity, b: destEntity) {
             newReferrer = "\(referrerScheme)://\(referrerHost)/"
@@ -135,7 +135,7 @@ public class ReferrerTrimming {
             onBeginNavigation(to: destUrl)
         }
 
-        guard let trackerData = contentBlockingManager.currentMainRules?.trackerData else {
+        guard let trackerDataIndex = contentBlockingManager.currentMainRules?.trackerDataIndex else {
             return nil
         }
 
@@ -146,7 +146,7 @@ public class ReferrerTrimming {
         if let newReferrer = getTrimmedReferrer(originUrl: originUrl,
                                                 destUrl: destUrl,
                                                 referrerUrl: URL(string: referrerHeader) ?? nil,
-                                                trackerData: trackerData) {
+                                                trackerDataIndex: trackerDataIndex) {
             var request = request
             request.setValue(newReferrer, forHTTPHeaderField: Constants.headerName)
             return request
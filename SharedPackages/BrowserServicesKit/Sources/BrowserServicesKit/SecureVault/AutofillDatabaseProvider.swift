@@ -88,6 +88,8 @@ public final class DefaultAutofillDatabaseProvider: GRDBSecureStorageDatabasePro
         static let dbFileName = "Vault.db"
     }
 
+    private let topLevelDomainCache = WebsiteAccountDomainCache()
+
     public static func defaultDatabaseURL() -> URL {
         return DefaultAutofillDatabaseProvider.databaseFilePath(directoryName: Constants.dbDirectoryName, fileName: Constants.dbFileName, appGroupIdentifier: nil)
     }
@@ -128,8 +130,11 @@ public final class DefaultAutofillDatabaseProvider: GRDBSecureStorageDatabasePro
                 migrator.registerMigration("v11", migrate: Self.migrateV11(database:))
                 migrator.registerMigration("v12", migrate: Self.migrateV12(database:))
                 migrator.registerMigration("v13", migrate: Self.migrateV13(database:))
+                migrator.registerMigration("v14", migrate: Self.migrateV14(database:))
             }
         }
+
+        db.add(transactionObserver: topLevelDomainCache)
     }
 
     private static func migrateDatabaseToSharedGroupIfNeeded(using fileStorageManager: FileStorageManaging = AppGroupFileStorageManager(),
@@ -185,12 +190,38 @@ public final class DefaultAutofillDatabaseProvider: GRDBSecureStorageDatabasePro
     }
 
     public func websiteAccountsForTopLevelDomain(_ eTLDplus1: String) throws -> [SecureVaultModels.WebsiteAccount] {
-        return try db.read { db in
-            let query = SecureVaultModels.WebsiteAccount
-                .filter(Column(SecureVaultModels.WebsiteAccount.Columns.domain.name) == eTLDplus1 ||
-                        Column(SecureVaultModels.WebsiteAccount.Columns.domain.name).like("%." + eTLDplus1))
-            return try query.fetchAll(db)
+        try db.read {
+            try websiteAccountsForTopLevelDomain(eTLDplus1, in: $0)
+        }
+    }
+
+    /// Matches accounts for `eTLDplus1` and all of its subdomains with a range scan over the reversed domain index.
+    ///
+    /// IDs of matching accounts are cached per domain, so repeated lookups (e.g. on every page load) are primary key fetches.
+    private func websiteAccountsForTopLevelDomain(_ eTLDplus1: String, in database: Database) throws -> [SecureVaultModels.WebsiteAccount] {
+        typealias Account = SecureVaultModels.WebsiteAccount
+
+        guard let key = Account.reversedDomain(eTLDplus1) else {
+            return []
+        }
+        let dataVersion = try Int.fetchOne(database, sql: "PRAGMA data_version") ?? 0
+
+        if let accountIds = topLevelDomainCache.accountIds(forKey: key, dataVersion: dataVersion) {
+            return try Account
+                .filter(keys: accountIds)
+                .order(Account.Columns.id)
+                .fetchAll(database)
         }
+
+        // All reversed subdomains of the key start with it, and sort between it and the key with its trailing dot bumped to "/".
+        let upperBound = String(key.dropLast()) + "/"
+        let accounts = try Account
+            .filter(Account.Columns.reversedDomain >= key && Account.Columns.reversedDomain < upperBound)
+            .order(Account.Columns.id)
+            .fetchAll(database)
+
+        topLevelDomainCache.store(accounts.compactMap { $0.id.flatMap(Int64.init) }, forKey: key, dataVersion: dataVersion)
+        return accounts
     }
 
     @discardableResult
@@ -460,10 +491,7 @@ public final class DefaultAutofillDatabaseProvider: GRDBSecureStorageDatabasePro
     }
 
     private func websiteCredentialsForTopLevelDomain(_ eTLDplus1: String, in database: Database) throws -> [SecureVaultModels.WebsiteCredentials] {
-        let query = SecureVaultModels.WebsiteAccount
-            .filter(Column(SecureVaultModels.WebsiteAccount.Columns.domain.name) == eTLDplus1 ||
-                    Column(SecureVaultModels.WebsiteAccount.Columns.domain.name).like("%." + eTLDplus1))
-        let accounts = try query.fetchAll(database)
+        let accounts = try websiteAccountsForTopLevelDomain(eTLDplus1, in: database)
 
         return try websiteCredentialsForAccounts(accounts, in: database)
     }
@@ -1113,6 +1141,39 @@ extension DefaultAutofillDatabaseProvider {
         }
     }
 
+    static func migrateV14(database: Database) throws {
+        typealias Account = SecureVaultModels.WebsiteAccount
+
+        try database.alter(table: Account.databaseTableName) {
+            $0.add(column: Account.Columns.reversedDomain.name, .text)
+        }
+
+        let accountRows = try Row.fetchCursor(database, sql: """
+            SELECT
+                \(Account.Columns.id.name), \(Account.Columns.domain.name)
+            FROM
+                \(Account.databaseTableName)
+            """)
+
+        while let accountRow = try accountRows.next() {
+            let domain: String? = accountRow[Account.Columns.domain.name]
+            try database.execute(sql: """
+                UPDATE
+                    \(Account.databaseTableName)
+                SET
+                    \(Account.Columns.reversedDomain.name) = ?
+                WHERE
+                    \(Account.Columns.id.name) = ?
+                """, arguments: [Account.reversedDomain(domain), accountRow[Account.Columns.id.name]])
+        }
+
+        try database.create(index: [Account.databaseTableName, Account.Columns.reversedDomain.name].joined(separator: "_"),
+                            on: Account.databaseTableName,
+                            columns: [Account.Columns.reversedDomain.name],
+                            unique: false,
+                            ifNotExists: false)
+    }
+
     // Refresh password comparison hashes
     static private func updatePasswordHashes(database: Database) throws {
         let accountRows = try Row.fetchCursor(database, sql: "SELECT * FROM \(SecureVaultModels.WebsiteAccount.databaseTableName)")
@@ -1216,6 +1277,18 @@ extension SecureVaultModels.WebsiteAccount: PersistableRecord, FetchableRecord {
 
     public enum Columns: String, ColumnExpression {
         case id, title, username, domain, signature, notes, created, lastUpdated, lastUsed
+        case reversedDomain
+    }
+
+    /// Lowercased domain labels in reverse order, each followed by a dot, e.g. `com.example.www.` for `www.example.com`.
+    ///
+    /// Stored alongside the domain, so that an account and all of its subdomains form a contiguous range in the index.
+    static func reversedDomain(_ domain: String?) -> String? {
+        guard let domain else { return nil }
+        return domain.lowercased()
+            .split(separator: ".", omittingEmptySubsequences: false)
+            .reversed()
+            .joined(separator: ".") + "."
     }
 
     public init(row: Row) {
@@ -1240,6 +1313,7 @@ extension SecureVaultModels.WebsiteAccount: PersistableRecord, FetchableRecord {
         container[Columns.created] = created
         container[Columns.lastUpdated] = Date()
         container[Columns.lastUsed] = lastUsed
+        container[Columns.reversedDomain] = Self.reversedDomain(domain)
     }
 
     public static var databaseTableName: String = "website_accounts"
@@ -0,0 +1,104 @@
+//
+//  WebsiteAccountDomainCache.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import GRDB
+
+/// Caches IDs of website accounts matching a top level domain (eTLD+1).
+///
+/// The cache observes the database connection and is cleared whenever a transaction inserts, deletes or changes the domain
+/// of a website account. Changes committed by other processes (e.g. the autofill extension) are detected by comparing
+/// `PRAGMA data_version` values, which callers pass along with every lookup.
+final class WebsiteAccountDomainCache: TransactionObserver {
+
+    static let defaultCapacity = 128
+
+    private let capacity: Int
+    private let lock = NSLock()
+    private var accountIds = [String: [Int64]]()
+    private var dataVersion: Int?
+    private var hasUncommittedChanges = false
+
+    init(capacity: Int = WebsiteAccountDomainCache.defaultCapacity) {
+        self.capacity = capacity
+    }
+
+    func accountIds(forKey key: String, dataVersion: Int) -> [Int64]? {
+        lock.lock(); defer { lock.unlock() }
+        guard !hasUncommittedChanges else { return nil }
+        guard self.dataVersion == dataVersion else {
+            accountIds.removeAll()
+            self.dataVersion = dataVersion
+            return nil
+        }
+        return accountIds[key]
+    }
+
+    func store(_ ids: [Int64], forKey key: String, dataVersion: Int) {
+        lock.lock(); defer { lock.unlock() }
+        // Results read inside a transaction that changed accounts may still be rolled back.
+        guard !hasUncommittedChanges, self.dataVersion == dataVersion else { return }
+        if accountIds.count >= capacity {
+            accountIds.removeAll()
+        }
+        accountIds[key] = ids
+    }
+
+    func removeAll() {
+        lock.lock(); defer { lock.unlock() }
+        accountIds.removeAll()
+    }
+
+    // MARK: - TransactionObserver
+
+    func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool {
+        typealias Account = SecureVaultModels.WebsiteAccount
+
+        switch eventKind {
+        case .insert(let tableName), .delete(let tableName):
+            return tableName == Account.databaseTableName
+        case .update(let tableName, let columnNames):
+            // Last used date is updated on every autofill, and doesn't affect domain matching.
+            return tableName == Account.databaseTableName
+                && !columnNames.isDisjoint(with: [Account.Columns.domain.name, Account.Columns.reversedDomain.name])
+        }
+    }
+
+    func databaseDidChange(with event: DatabaseEvent) {
+        lock.lock(); defer { lock.unlock() }
+        hasUncommittedChanges = true
+        accountIds.removeAll()
+    }
+
+    func databaseDidCommit(_ db: Database) {
+        transactionDidEnd()
+    }
+
+    func databaseDidRollback(_ db: Database) {
+        transactionDidEnd()
+    }
+
+    private func transactionDidEnd() {
+        lock.lock(); defer { lock.unlock() }
+        if hasUncommittedChanges {
+            hasUncommittedChanges = false
+            accountIds.removeAll()
+        }
+    }
+
+}
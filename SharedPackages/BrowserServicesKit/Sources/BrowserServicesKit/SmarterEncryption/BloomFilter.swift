@@ -20,17 +20,36 @@ import BloomFilterWrapper
 
 public struct BloomFilter {
 
-    let wrapper: BloomFilterWrapper
+    private enum Storage {
+        case wrapper(BloomFilterWrapper)
+        case snapshot(ProtectionDataSnapshot.HTTPSBloomFilter)
+    }
+
+    private let storage: Storage
     let specification: HTTPSBloomFilterSpecification
 
     public init(wrapper: BloomFilterWrapper, specification: HTTPSBloomFilterSpecification) {
-        self.wrapper = wrapper
+        self.storage = .wrapper(wrapper)
         self.specification = specification
     }
 
+    /// Bloom filter queried in place in a memory-mapped protection data snapshot, shared with other processes
+    public init(snapshot bloomFilter: ProtectionDataSnapshot.HTTPSBloomFilter) {
+        self.storage = .snapshot(bloomFilter)
+        self.specification = bloomFilter.specification
+    }
+
+    var wrapper: BloomFilterWrapper? {
+        guard case .wrapper(let wrapper) = storage else { return nil }
+        return wrapper
+    }
+
     @MainActor
     func containsHost(_ host: String) -> Bool {
-        wrapper.contains(host)
+        switch storage {
+        case .wrapper(let wrapper): wrapper.contains(host)
+        case .snapshot(let bloomFilter): bloomFilter.contains(host)
+        }
     }
 
 }
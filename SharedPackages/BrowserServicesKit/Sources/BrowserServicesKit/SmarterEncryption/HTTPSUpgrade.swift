@@ -48,6 +48,9 @@ public actor HTTPSUpgrade {
 
     @MainActor
     public func upgrade(url: URL) async -> Result<URL, HTTPSUpgradeError> {
+        let span = Tracer.beginSpan("HTTPSUpgrade.upgrade")
+        defer { span.end() }
+
         guard url.isHttp else { return .failure(.nonHttp) }
         guard let host = url.host else { return .failure(.badUrl) }
         guard shouldExcludeDomain(host) == false else { return .failure(.domainExcluded) }
@@ -100,7 +103,7 @@ public actor HTTPSUpgrade {
             _=await dataReloadTask.value
         }
         dataReloadTask = Task.detached { [store] in
-            return store.loadBloomFilter().map { BloomFilter(wrapper: $0.wrapper, specification: $0.specification) }
+            return store.loadBloomFilter()
         }
         self.bloomFilter = await dataReloadTask!.value
         self.dataReloadTask = nil
@@ -108,7 +111,7 @@ public actor HTTPSUpgrade {
 
     private func reloadBloomFilter() async -> BloomFilter? {
         logger.debug("Reloading Bloom Filter")
-        let bloomFilter = store.loadBloomFilter().map { BloomFilter(wrapper: $0.wrapper, specification: $0.specification) }
+        let bloomFilter = store.loadBloomFilter()
         self.bloomFilter = bloomFilter
         return bloomFilter
     }
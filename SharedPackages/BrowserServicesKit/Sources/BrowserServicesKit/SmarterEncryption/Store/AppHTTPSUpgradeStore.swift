@@ -212,12 +212,38 @@ public struct AppHTTPSUpgradeStore: HTTPSUpgradeStore {
         }
     }
 
+    private func loadExcludedDomains() -> [String] {
+        var domains = [String]()
+        context.performAndWait {
+            let request: NSFetchRequest<HTTPSExcludedDomain> = HTTPSExcludedDomain.fetchRequest()
+            domains = ((try? context.fetch(request)) ?? []).compactMap(\.domain)
+        }
+        return domains
+    }
+
     private func deleteExcludedDomains() {
         context.performAndWait {
             context.deleteAll(matching: HTTPSExcludedDomain.fetchRequest())
         }
     }
 
+    /// Adds the stored Bloom filter and excluded domains to a protection data snapshot, to share them with other processes.
+    public func addStoredData(to builder: inout ProtectionDataSnapshotBuilder) throws {
+        let specification: HTTPSBloomFilterSpecification
+        if let storedBloomFilterSpecification = loadStoredBloomFilterSpecification(),
+           storedBloomFilterSpecification.sha256 == storedBloomFilterDataHash {
+            specification = storedBloomFilterSpecification
+        } else {
+            specification = try loadAndPersistEmbeddedData().specification
+        }
+
+        let data = try Data(contentsOf: bloomFilterDataURL)
+        guard data.sha256 == specification.sha256 else { throw Error.specMismatch }
+
+        try builder.addHTTPSBloomFilter(specification: specification, data: data)
+        try builder.addHTTPSExcludedDomains(loadExcludedDomains())
+    }
+
     func reset() {
         logger.log("Resetting")
 
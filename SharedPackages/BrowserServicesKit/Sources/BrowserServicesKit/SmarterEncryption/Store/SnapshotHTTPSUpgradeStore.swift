@@ -0,0 +1,114 @@
+//
+//  SnapshotHTTPSUpgradeStore.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import os.log
+
+/// Reads the Bloom filter and excluded domains from the shared protection data snapshot when it contains them,
+/// and from `fallbackStore` otherwise. Updates are persisted to `fallbackStore`, to be published in the next snapshot;
+/// until then, this store reads the updated data from `fallbackStore` rather than the outdated snapshot.
+///
+/// Call `HTTPSUpgrade.loadDataAsync()` when `snapshotStore` swaps to a new generation, to release the previous one.
+public struct SnapshotHTTPSUpgradeStore: HTTPSUpgradeStore {
+
+    private let snapshotStore: ProtectionDataSnapshotStore
+    private let fallbackStore: HTTPSUpgradeStore
+    private let publishesUpdates: Bool
+    private let unpublishedUpdates = UnpublishedUpdates()
+
+    /// - Parameter publishesUpdates: whether persisted updates are also published to the snapshot,
+    ///   in the process that updates the HTTPS upgrade data.
+    public init(snapshotStore: ProtectionDataSnapshotStore, fallbackStore: HTTPSUpgradeStore, publishesUpdates: Bool = false) {
+        self.snapshotStore = snapshotStore
+        self.fallbackStore = fallbackStore
+        self.publishesUpdates = publishesUpdates
+    }
+
+    public func loadBloomFilter() -> BloomFilter? {
+        if let bloomFilter = snapshotStore.snapshot?.httpsBloomFilter,
+           unpublishedUpdates.isBloomFilterPublished(sha256: bloomFilter.specification.sha256) {
+            return BloomFilter(snapshot: bloomFilter)
+        }
+        return fallbackStore.loadBloomFilter()
+    }
+
+    public func persistBloomFilter(specification: HTTPSBloomFilterSpecification, data: Data) throws {
+        try fallbackStore.persistBloomFilter(specification: specification, data: data)
+        unpublishedUpdates.bloomFilterPersisted(sha256: specification.sha256)
+        publishIfNeeded { try $0.addHTTPSBloomFilter(specification: specification, data: data) }
+    }
+
+    public func hasExcludedDomain(_ domain: String) -> Bool {
+        if let snapshot = snapshotStore.snapshot,
+           let excludedDomains = snapshot.httpsExcludedDomains,
+           unpublishedUpdates.areExcludedDomainsPublished(inGeneration: snapshot.generation) {
+            return excludedDomains.contains(domain.lowercased())
+        }
+        return fallbackStore.hasExcludedDomain(domain)
+    }
+
+    public func persistExcludedDomains(_ domains: [String]) throws {
+        try fallbackStore.persistExcludedDomains(domains)
+        unpublishedUpdates.excludedDomainsPersisted(afterGeneration: snapshotStore.snapshot?.generation ?? 0)
+        publishIfNeeded { try $0.addHTTPSExcludedDomains(domains) }
+    }
+
+    /// Failing to publish is not an error of the update: it's read from `fallbackStore` until published.
+    private func publishIfNeeded(_ addSection: (inout ProtectionDataSnapshotBuilder) throws -> Void) {
+        guard publishesUpdates else { return }
+        do {
+            var builder = ProtectionDataSnapshotBuilder()
+            try addSection(&builder)
+            try snapshotStore.publish(builder)
+        } catch {
+            Logger.protectionDataSnapshot.error("Failed to publish HTTPS upgrade data: \(String(describing: error), privacy: .public)")
+        }
+    }
+
+}
+
+/// Data persisted to the fallback store that the mapped snapshot may not contain yet
+private final class UnpublishedUpdates {
+
+    private let lock = NSLock()
+    private var bloomFilterSHA256: String?
+    private var excludedDomainsGeneration: UInt64?
+
+    func bloomFilterPersisted(sha256: String) {
+        lock.lock(); defer { lock.unlock() }
+        bloomFilterSHA256 = sha256
+    }
+
+    /// The Bloom filter of a snapshot is up to date when it’s the last persisted one.
+    func isBloomFilterPublished(sha256: String) -> Bool {
+        lock.lock(); defer { lock.unlock() }
+        return bloomFilterSHA256 == nil || bloomFilterSHA256 == sha256
+    }
+
+    func excludedDomainsPersisted(afterGeneration generation: UInt64) {
+        lock.lock(); defer { lock.unlock() }
+        excludedDomainsGeneration = generation
+    }
+
+    /// Excluded domains have no checksum: they’re up to date in any generation published after they were persisted.
+    func areExcludedDomainsPublished(inGeneration generation: UInt64) -> Bool {
+        lock.lock(); defer { lock.unlock() }
+        return excludedDomainsGeneration.map { generation > $0 } ?? true
+    }
+
+}
@@ -0,0 +1,105 @@
+//
+//  Tracer.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CommonTracing
+import Foundation
+
+/// Low-overhead tracing of hot paths (per navigation or per request), exported as Chrome trace-event JSON.
+///
+/// Events go to per-thread ring buffers (see `CommonTracing.h`, which ObjC and C targets can use directly) without locks.
+/// Recording is disabled by default and costs a single check while disabled; define `DDG_TRACING_DISABLED` to compile it out.
+///
+/// ```
+/// let span = Tracer.beginSpan("HTTPSUpgrade.upgrade")
+/// defer { span.end() }
+/// ```
+/// Spans are recorded as complete events when they end, so they may start and end on different threads.
+public enum Tracer {
+
+    // Names point to string literals, which are immutable and never deallocated.
+    public struct Span: @unchecked Sendable {
+        fileprivate let name: UnsafePointer<CChar>?
+        fileprivate let start: UInt64
+
+        public func end() {
+#if !DDG_TRACING_DISABLED
+            guard start != 0, let name else { return }
+            ddg_trace_record_span(name, start)
+#endif
+        }
+    }
+
+    public static var isEnabled: Bool {
+        get { ddg_trace_is_enabled() }
+        set { ddg_trace_set_enabled(newValue) }
+    }
+
+    /// - Parameter name: A string literal; only its address is recorded.
+    public static func beginSpan(_ name: StaticString) -> Span {
+#if DDG_TRACING_DISABLED
+        return Span(name: nil, start: 0)
+#else
+        guard ddg_trace_is_enabled() else { return Span(name: nil, start: 0) }
+        return Span(name: cString(name), start: ddg_trace_now())
+#endif
+    }
+
+    public static func span<T>(_ name: StaticString, _ body: () throws -> T) rethrows -> T {
+        let span = beginSpan(name)
+        defer { span.end() }
+        return try body()
+    }
+
+    public static func span<T>(_ name: StaticString, _ body: () async throws -> T) async rethrows -> T {
+        let span = beginSpan(name)
+        defer { span.end() }
+        return try await body()
+    }
+
+    /// - Parameter name: A string literal; only its address is recorded.
+    public static func counter(_ name: StaticString, _ value: Int) {
+#if !DDG_TRACING_DISABLED
+        guard ddg_trace_is_enabled(), let name = cString(name) else { return }
+        ddg_trace_record_counter(name, Int64(value))
+#endif
+    }
+
+    /// Drop events recorded so far.
+    public static func reset() {
+        ddg_trace_reset()
+    }
+
+    /// Events of all threads as Chrome trace-event JSON, to be loaded in `chrome://tracing` or Perfetto.
+    public static func exportChromeTrace() -> Data {
+        var data = Data()
+        withUnsafeMutablePointer(to: &data) { data in
+            ddg_trace_export_chrome_trace({ bytes, length, context in
+                guard let bytes, let context else { return }
+                context.assumingMemoryBound(to: Data.self).pointee.append(UnsafeRawPointer(bytes).assumingMemoryBound(to: UInt8.self), count: length)
+            }, data)
+        }
+        return data
+    }
+
+    private static func cString(_ name: StaticString) -> UnsafePointer<CChar>? {
+        // String literals are stored null-terminated; single scalar literals have no pointer representation.
+        guard name.hasPointerRepresentation else { return nil }
+        return UnsafeRawPointer(name.utf8Start).assumingMemoryBound(to: CChar.self)
+    }
+
+}
@@ -0,0 +1,236 @@
+//
+//  CommonTracing.c
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "CommonTracing.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef enum {
+    ddg_trace_phase_complete = 'X',
+    ddg_trace_phase_counter = 'C',
+} ddg_trace_phase;
+
+typedef struct {
+    const char *name;
+    uint64_t timestamp_ns;
+    // duration for spans, value for counters
+    int64_t value;
+    uint32_t thread_id;
+    char phase;
+} ddg_trace_event;
+
+// Each buffer is written only by the thread owning it. `head` counts all events ever written and is published
+// with release ordering after the event is stored, so readers know which slots hold complete events.
+// Buffers are never freed: when a thread exits, its buffer is handed over to the next thread recording an event.
+typedef struct ddg_trace_buffer {
+    struct ddg_trace_buffer *next;
+    atomic_bool in_use;
+    _Atomic uint64_t head;
+    ddg_trace_event events[DDG_TRACE_THREAD_BUFFER_CAPACITY];
+} ddg_trace_buffer;
+
+static atomic_bool trace_enabled = false;
+static _Atomic uint64_t reset_timestamp = 0;
+static _Atomic(ddg_trace_buffer *) trace_buffers = NULL;
+static _Atomic uint32_t next_thread_id = 1;
+
+static pthread_key_t buffer_key;
+static pthread_once_t buffer_key_once = PTHREAD_ONCE_INIT;
+static _Thread_local ddg_trace_buffer *thread_buffer = NULL;
+static _Thread_local uint32_t thread_id = 0;
+
+static void release_buffer(void *buffer) {
+    // Events recorded by later thread-local destructors claim a new buffer instead of writing to the released one.
+    thread_buffer = NULL;
+    atomic_store_explicit(&((ddg_trace_buffer *)buffer)->in_use, false, memory_order_release);
+}
+
+static void create_buffer_key(void) {
+    pthread_key_create(&buffer_key, release_buffer);
+}
+
+static ddg_trace_buffer *claim_buffer(void) {
+    for (ddg_trace_buffer *buffer = atomic_load_explicit(&trace_buffers, memory_order_acquire); buffer; buffer = buffer->next) {
+        bool in_use = false;
+        if (atomic_compare_exchange_strong_explicit(&buffer->in_use, &in_use, true, memory_order_acquire, memory_order_relaxed)) {
+            return buffer;
+        }
+    }
+
+    ddg_trace_buffer *buffer = calloc(1, sizeof(ddg_trace_buffer));
+    if (!buffer) {
+        return NULL;
+    }
+    atomic_init(&buffer->in_use, true);
+    atomic_init(&buffer->head, 0);
+
+    ddg_trace_buffer *head = atomic_load_explicit(&trace_buffers, memory_order_relaxed);
+    do {
+        buffer->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&trace_buffers, &head, buffer, memory_order_release, memory_order_relaxed));
+    return buffer;
+}
+
+static ddg_trace_buffer *current_buffer(void) {
+    if (thread_buffer) {
+        return thread_buffer;
+    }
+    pthread_once(&buffer_key_once, create_buffer_key);
+    ddg_trace_buffer *buffer = claim_buffer();
+    if (buffer) {
+        // the key destructor releases the buffer when the thread exits
+        pthread_setspecific(buffer_key, buffer);
+        thread_buffer = buffer;
+        thread_id = atomic_fetch_add_explicit(&next_thread_id, 1, memory_order_relaxed);
+    }
+    return buffer;
+}
+
+static void record_event(const char *name, uint64_t timestamp_ns, int64_t value, char phase) {
+    ddg_trace_buffer *buffer = current_buffer();
+    if (!buffer) {
+        return;
+    }
+    uint64_t head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    ddg_trace_event *event = &buffer->events[head % DDG_TRACE_THREAD_BUFFER_CAPACITY];
+    event->name = name;
+    event->timestamp_ns = timestamp_ns;
+    event->value = value;
+    event->thread_id = thread_id;
+    event->phase = phase;
+    atomic_store_explicit(&buffer->head, head + 1, memory_order_release);
+}
+
+void ddg_trace_set_enabled(bool enabled) {
+    atomic_store_explicit(&trace_enabled, enabled, memory_order_relaxed);
+}
+
+bool ddg_trace_is_enabled(void) {
+    return atomic_load_explicit(&trace_enabled, memory_order_relaxed);
+}
+
+uint64_t ddg_trace_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+void ddg_trace_record_span(const char *name, uint64_t start_ns) {
+    if (!ddg_trace_is_enabled()) {
+        return;
+    }
+    uint64_t now = ddg_trace_now();
+    record_event(name, start_ns, (int64_t)(now - start_ns), ddg_trace_phase_complete);
+}
+
+void ddg_trace_record_counter(const char *name, int64_t value) {
+    if (!ddg_trace_is_enabled()) {
+        return;
+    }
+    record_event(name, ddg_trace_now(), value, ddg_trace_phase_counter);
+}
+
+void ddg_trace_reset(void) {
+    atomic_store_explicit(&reset_timestamp, ddg_trace_now(), memory_order_relaxed);
+}
+
+// MARK: - Chrome trace export
+
+typedef struct {
+    ddg_trace_write_fn write;
+    void *context;
+    bool has_events;
+} ddg_trace_writer;
+
+static void write_string(ddg_trace_writer *writer, const char *string) {
+    writer->write(string, strlen(string), writer->context);
+}
+
+static void write_json_string(ddg_trace_writer *writer, const char *string) {
+    char escaped[512];
+    size_t length = 0;
+    escaped[length++] = '"';
+    for (const char *character = string; *character && length < sizeof(escaped) - 8; character++) {
+        unsigned char byte = (unsigned char)*character;
+        if (byte == '"' || byte == '\\') {
+            escaped[length++] = '\\';
+            escaped[length++] = (char)byte;
+        } else if (byte < 0x20) {
+            length += (size_t)snprintf(escaped + length, sizeof(escaped) - length, "\\u%04x", byte);
+        } else {
+            escaped[length++] = (char)byte;
+        }
+    }
+    escaped[length++] = '"';
+    writer->write(escaped, length, writer->context);
+}
+
+static void write_event(ddg_trace_writer *writer, const ddg_trace_event *event) {
+    char buffer[256];
+    write_string(writer, writer->has_events ? ",\n{\"name\":" : "\n{\"name\":");
+    writer->has_events = true;
+    write_json_string(writer, event->name ? event->name : "");
+
+    // timestamps and durations are in microseconds
+    int length = snprintf(buffer, sizeof(buffer), ",\"ph\":\"%c\",\"ts\":%" PRIu64 ".%03" PRIu64 ",\"pid\":1,\"tid\":%" PRIu32,
+                          event->phase, event->timestamp_ns / 1000, event->timestamp_ns % 1000, event->thread_id);
+    writer->write(buffer, (size_t)length, writer->context);
+
+    if (event->phase == ddg_trace_phase_complete) {
+        uint64_t duration = (uint64_t)event->value;
+        length = snprintf(buffer, sizeof(buffer), ",\"dur\":%" PRIu64 ".%03" PRIu64 "}", duration / 1000, duration % 1000);
+    } else {
+        length = snprintf(buffer, sizeof(buffer), ",\"args\":{\"value\":%" PRId64 "}}", event->value);
+    }
+    writer->write(buffer, (size_t)length, writer->context);
+}
+
+void ddg_trace_export_chrome_trace(ddg_trace_write_fn write, void *context) {
+    ddg_trace_writer writer = { write, context, false };
+    uint64_t reset = atomic_load_explicit(&reset_timestamp, memory_order_relaxed);
+    ddg_trace_event *events = malloc(sizeof(ddg_trace_event) * DDG_TRACE_THREAD_BUFFER_CAPACITY);
+
+    write_string(&writer, "{\"traceEvents\":[");
+    for (ddg_trace_buffer *buffer = atomic_load_explicit(&trace_buffers, memory_order_acquire); buffer && events; buffer = buffer->next) {
+        uint64_t head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+        uint64_t first = head > DDG_TRACE_THREAD_BUFFER_CAPACITY ? head - DDG_TRACE_THREAD_BUFFER_CAPACITY : 0;
+        for (uint64_t index = first; index < head; index++) {
+            events[index - first] = buffer->events[index % DDG_TRACE_THREAD_BUFFER_CAPACITY];
+        }
+
+        // Events the owning thread overwrote while they were being copied may be torn: skip them.
+        // The event at `new_head` may already be being written over the slot of `new_head - capacity`.
+        uint64_t new_head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+        uint64_t first_intact = new_head + 1 > DDG_TRACE_THREAD_BUFFER_CAPACITY ? new_head + 1 - DDG_TRACE_THREAD_BUFFER_CAPACITY : 0;
+        for (uint64_t index = first > first_intact ? first : first_intact; index < head; index++) {
+            const ddg_trace_event *event = &events[index - first];
+            if (event->timestamp_ns >= reset) {
+                write_event(&writer, event);
+            }
+        }
+    }
+    write_string(&writer, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    free(events);
+}
@@ -0,0 +1,105 @@
+//
+//  CommonTracing.h
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef CommonTracing_h
+#define CommonTracing_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of events kept per thread; older events are overwritten.
+#define DDG_TRACE_THREAD_BUFFER_CAPACITY 8192
+
+/// Enable or disable event recording at runtime (disabled by default).
+/// While disabled, recording an event costs a call and a relaxed atomic load.
+void ddg_trace_set_enabled(bool enabled);
+bool ddg_trace_is_enabled(void);
+
+/// Monotonic timestamp in nanoseconds used for all events.
+uint64_t ddg_trace_now(void);
+
+/// Record a span that started at `start_ns` and ends now, as a Chrome trace "complete" event.
+/// - Note: `name` must be a string with static storage duration (e.g. a literal); only the pointer is stored.
+void ddg_trace_record_span(const char *name, uint64_t start_ns);
+
+/// Record a counter value, as a Chrome trace "counter" event.
+/// - Note: `name` must be a string with static storage duration (e.g. a literal); only the pointer is stored.
+void ddg_trace_record_counter(const char *name, int64_t value);
+
+/// Drop all events recorded so far. Events being recorded concurrently may or may not be kept.
+void ddg_trace_reset(void);
+
+typedef void (*ddg_trace_write_fn)(const char *bytes, size_t length, void *context);
+
+/// Write events of all threads as Chrome trace-event JSON (`{"traceEvents":[...]}`), in chunks passed to `write`.
+/// The output can be loaded in `chrome://tracing` or Perfetto.
+void ddg_trace_export_chrome_trace(ddg_trace_write_fn write, void *context);
+
+typedef struct {
+    const char *name;
+    uint64_t start_ns;
+} ddg_trace_scope_t;
+
+static inline ddg_trace_scope_t ddg_trace_scope_begin(const char *name) {
+    ddg_trace_scope_t scope = { name, ddg_trace_is_enabled() ? ddg_trace_now() : 0 };
+    return scope;
+}
+
+static inline void ddg_trace_scope_end(ddg_trace_scope_t *scope) {
+    if (scope->start_ns != 0) {
+        ddg_trace_record_span(scope->name, scope->start_ns);
+    }
+}
+
+// Tracing macros compile to nothing when `DDG_TRACING_DISABLED` is defined.
+#ifndef DDG_TRACING_DISABLED
+
+#define DDG_TRACE_CONCAT_(a, b) a ## b
+#define DDG_TRACE_CONCAT(a, b) DDG_TRACE_CONCAT_(a, b)
+
+/// Trace the enclosing scope as a span: `DDG_TRACE_SCOPE("BloomFilter.contains");`
+#define DDG_TRACE_SCOPE(name) \
+    ddg_trace_scope_t DDG_TRACE_CONCAT(ddg_trace_scope_, __LINE__) __attribute__((cleanup(ddg_trace_scope_end), unused)) = ddg_trace_scope_begin(name)
+
+/// Start a span ended with `DDG_TRACE_SPAN_END` in the same scope.
+#define DDG_TRACE_SPAN_BEGIN(variable, name) ddg_trace_scope_t variable = ddg_trace_scope_begin(name)
+#define DDG_TRACE_SPAN_END(variable) ddg_trace_scope_end(&(variable))
+
+/// Record a counter value: `DDG_TRACE_COUNTER("Rules.count", count);`
+#define DDG_TRACE_COUNTER(name, value) \
+    do { if (ddg_trace_is_enabled()) { ddg_trace_record_counter(name, (int64_t)(value)); } } while (0)
+
+#else
+
+#define DDG_TRACE_SCOPE(name) do {} while (0)
+#define DDG_TRACE_SPAN_BEGIN(variable, name) do {} while (0)
+#define DDG_TRACE_SPAN_END(variable) do {} while (0)
+#define DDG_TRACE_COUNTER(name, value) do {} while (0)
+
+#endif // DDG_TRACING_DISABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CommonTracing_h
@@ -0,0 +1,104 @@
+//
+//  ContentBlockerRulesBenchmark.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import TrackerRadarKit
+import ContentBlocking
+
+/**
+ Measures sharded rule generation over a Tracker Data Set.
+
+ Usage: `swift run ContentBlockerRulesBenchmark <path to trackerData.json> [shard count]`,
+ e.g. with the embedded data set from `macOS/DuckDuckGo/ContentBlocker/trackerData.json`.
+ */
+@main
+struct ContentBlockerRulesBenchmark {
+
+    static func main() throws {
+        let arguments = CommandLine.arguments
+        guard arguments.count > 1 else {
+            print("Usage: ContentBlockerRulesBenchmark <trackerData.json> [shard count]")
+            exit(1)
+        }
+
+        let data = try Data(contentsOf: URL(fileURLWithPath: arguments[1]))
+        let tds = try JSONDecoder().decode(TrackerData.self, from: data)
+        let shardCount = arguments.count > 2 ? Int(arguments[2]) ?? 32 : 32
+
+        print("Trackers: \(tds.trackers.count), entities: \(tds.entities.count), shards: \(shardCount)")
+
+        let baseline = measureUnsharded(tds: tds)
+        print(String(format: "unsharded generation: %.1f ms", baseline * 1000))
+
+        let generator = ContentBlockerRulesShardGenerator(shardCount: shardCount, cache: InMemoryContentBlockerRulesShardCache())
+        let unprotectedSites = ["example.com"]
+        let tempList = ["example.net"]
+
+        run("cold generation", generator: generator, tds: tds, unprotectedSites: unprotectedSites, tempList: tempList, allowList: [])
+        run("unchanged inputs", generator: generator, tds: tds, unprotectedSites: unprotectedSites, tempList: tempList, allowList: [])
+        run("unprotected site added", generator: generator, tds: tds,
+            unprotectedSites: unprotectedSites + ["example.org"], tempList: tempList, allowList: [])
+
+        guard let trackerDomain = tds.trackers.keys.sorted().first else { return }
+
+        let allowList = [TrackerException(rule: trackerDomain + "/", matching: .all)]
+        run("allowlist toggle", generator: generator, tds: tds, unprotectedSites: unprotectedSites, tempList: tempList, allowList: allowList)
+
+        var trackers = tds.trackers
+        if let tracker = trackers[trackerDomain] {
+            trackers[trackerDomain] = KnownTracker(domain: tracker.domain,
+                                                   defaultAction: tracker.defaultAction == .block ? .ignore : .block,
+                                                   owner: tracker.owner,
+                                                   prevalence: tracker.prevalence,
+                                                   subdomains: tracker.subdomains,
+                                                   categories: tracker.categories,
+                                                   rules: tracker.rules)
+        }
+        let changedTDS = TrackerData(trackers: trackers, entities: tds.entities, domains: tds.domains, cnames: tds.cnames)
+        run("single tracker changed", generator: generator, tds: changedTDS, unprotectedSites: unprotectedSites, tempList: tempList, allowList: allowList)
+    }
+
+    private static func measureUnsharded(tds: TrackerData) -> TimeInterval {
+        let start = Date()
+        let rules = ContentBlockerRulesBuilder(trackerData: tds).buildRules(withExceptions: ["example.com"],
+                                                                           andTemporaryUnprotectedDomains: ["example.net"],
+                                                                           andTrackerAllowlist: [])
+        _ = try? JSONEncoder().encode(rules)
+        return Date().timeIntervalSince(start)
+    }
+
+    private static func run(_ name: String,
+                            generator: ContentBlockerRulesShardGenerator,
+                            tds: TrackerData,
+                            unprotectedSites: [String],
+                            tempList: [String],
+                            allowList: [TrackerException]) {
+        let start = Date()
+        guard let output = try? generator.generate(trackerData: tds,
+                                                   unprotectedSites: unprotectedSites,
+                                                   tempList: tempList,
+                                                   allowList: allowList) else {
+            print("\(name): generation failed")
+            return
+        }
+        let elapsed = Date().timeIntervalSince(start)
+        print(String(format: "%@: %.1f ms, shards touched: %d/%d, %d bytes",
+                     name, elapsed * 1000, output.regeneratedShards.count, output.shardDigests.count, output.encodedRules.count))
+    }
+
+}
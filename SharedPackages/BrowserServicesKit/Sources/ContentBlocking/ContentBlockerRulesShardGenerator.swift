@@ -0,0 +1,293 @@
+//
+//  ContentBlockerRulesShardGenerator.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import TrackerRadarKit
+
+/**
+ Storage for generated rule shards of each rules list, addressed by the digest of the shard's input.
+ */
+public protocol ContentBlockerRulesShardCaching: AnyObject {
+
+    func rules(forDigest digest: String, listName: String) -> Data?
+    func store(rules: Data, forDigest digest: String, listName: String)
+    /// Removes shards of the rules list that are not referenced by any of the given digests.
+    func removeShards(notIn digests: Set<String>, listName: String)
+
+}
+
+public final class InMemoryContentBlockerRulesShardCache: ContentBlockerRulesShardCaching {
+
+    private let lock = NSLock()
+    private var storage = [String: [String: Data]]()
+
+    public init() {}
+
+    public func rules(forDigest digest: String, listName: String) -> Data? {
+        lock.lock(); defer { lock.unlock() }
+        return storage[listName]?[digest]
+    }
+
+    public func store(rules: Data, forDigest digest: String, listName: String) {
+        lock.lock(); defer { lock.unlock() }
+        storage[listName, default: [:]][digest] = rules
+    }
+
+    public func removeShards(notIn digests: Set<String>, listName: String) {
+        lock.lock(); defer { lock.unlock() }
+        storage[listName] = storage[listName]?.filter { digests.contains($0.key) }
+    }
+
+}
+
+public final class FileContentBlockerRulesShardCache: ContentBlockerRulesShardCaching {
+
+    private let directory: URL
+    private let fileManager: FileManager
+
+    public init(directory: URL, fileManager: FileManager = .default) {
+        self.directory = directory
+        self.fileManager = fileManager
+    }
+
+    public func rules(forDigest digest: String, listName: String) -> Data? {
+        try? Data(contentsOf: fileURL(forDigest: digest, listName: listName))
+    }
+
+    public func store(rules: Data, forDigest digest: String, listName: String) {
+        try? fileManager.createDirectory(at: listDirectory(forListName: listName), withIntermediateDirectories: true)
+        try? rules.write(to: fileURL(forDigest: digest, listName: listName), options: .atomic)
+    }
+
+    public func removeShards(notIn digests: Set<String>, listName: String) {
+        let listDirectory = listDirectory(forListName: listName)
+        guard let files = try? fileManager.contentsOfDirectory(at: listDirectory, includingPropertiesForKeys: nil) else { return }
+        for file in files where file.pathExtension == "json" && !digests.contains(file.deletingPathExtension().lastPathComponent) {
+            try? fileManager.removeItem(at: file)
+        }
+    }
+
+    private func listDirectory(forListName listName: String) -> URL {
+        // List names are fixed identifiers, escape them anyway so that they always map to a single path component.
+        let component = listName.addingPercentEncoding(withAllowedCharacters: .alphanumerics) ?? listName
+        return directory.appendingPathComponent(component, isDirectory: true)
+    }
+
+    private func fileURL(forDigest digest: String, listName: String) -> URL {
+        listDirectory(forListName: listName).appendingPathComponent(digest).appendingPathExtension("json")
+    }
+
+}
+
+/**
+ Generates content blocking rules in shards, so that a change to the inputs only regenerates the affected part of the rule list.
+
+ Trackers are assigned to shards by a stable hash of their owning entity, keeping all trackers of an entity together.
+ Each shard's block rules are cached under a digest of its inputs. Tracker allowlist, unprotected and temporarily unprotected domains
+ produce `ignore-previous-rules` entries that must follow every block rule, as in the unsharded builder, so they are generated
+ separately and appended after all of the shards.
+ */
+public struct ContentBlockerRulesShardGenerator {
+
+    public struct Output {
+        /// Digest of every shard, indexed by shard number.
+        public let shardDigests: [String]
+        /// Shards that were not found in the cache and had to be generated.
+        public let regeneratedShards: [Int]
+        /// Complete rule list, encoded as a JSON array.
+        public let encodedRules: Data
+
+        public var encodedRulesString: String {
+            String(data: encodedRules, encoding: .utf8)!
+        }
+    }
+
+    // Bump when the shape of generated rules changes, to invalidate cached shards.
+    static let digestVersion = "2"
+
+    public let shardCount: Int
+    private let cache: ContentBlockerRulesShardCaching
+
+    public init(shardCount: Int = 32, cache: ContentBlockerRulesShardCaching) {
+        precondition(shardCount > 0)
+        self.shardCount = shardCount
+        self.cache = cache
+    }
+
+    public func generate(trackerData: TrackerData,
+                         unprotectedSites: [String],
+                         tempList: [String],
+                         allowList: [TrackerException],
+                         listName: String = "") throws -> Output {
+        let inputs = makeShardInputs(trackerData: trackerData)
+
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+
+        var digests = [String]()
+        var regenerated = [Int]()
+        var parts = [Data]()
+        digests.reserveCapacity(shardCount)
+        parts.reserveCapacity(shardCount + 1)
+
+        for (index, shardTDS) in inputs.enumerated() {
+            var digest = FNV1a128()
+            digest.combine(Self.digestVersion)
+            digest.combine(try encoder.encode(shardTDS))
+            let digestValue = digest.hexValue
+            digests.append(digestValue)
+
+            if let cached = cache.rules(forDigest: digestValue, listName: listName) {
+                parts.append(cached)
+                continue
+            }
+
+            let rules = ContentBlockerRulesBuilder(trackerData: shardTDS).buildRules(withExceptions: nil,
+                                                                                    andTemporaryUnprotectedDomains: nil,
+                                                                                    andTrackerAllowlist: [])
+            let data = try JSONEncoder().encode(rules)
+            cache.store(rules: data, forDigest: digestValue, listName: listName)
+            parts.append(data)
+            regenerated.append(index)
+        }
+
+        if !allowList.isEmpty || !unprotectedSites.isEmpty || !tempList.isEmpty {
+            // Without trackers the builder only emits the ignore-previous-rules entries, in the same order as for the whole list.
+            let emptyTDS = TrackerData(trackers: [:], entities: [:], domains: [:], cnames: nil)
+            let exceptions = ContentBlockerRulesBuilder(trackerData: emptyTDS).buildRules(withExceptions: unprotectedSites,
+                                                                                         andTemporaryUnprotectedDomains: tempList,
+                                                                                         andTrackerAllowlist: allowList)
+            parts.append(try JSONEncoder().encode(exceptions))
+        }
+
+        return Output(shardDigests: digests,
+                      regeneratedShards: regenerated,
+                      encodedRules: Self.concatenate(encodedArrays: parts))
+    }
+
+    /// Removes cached shards of the rules list that are not part of `output`.
+    public func removeUnusedShards(keeping output: Output, listName: String = "") {
+        cache.removeShards(notIn: Set(output.shardDigests), listName: listName)
+    }
+
+    public func shardIndex(forEntityNamed name: String) -> Int {
+        var hash = FNV1a128()
+        hash.combine(name)
+        return Int(hash.low % UInt64(shardCount))
+    }
+
+    private struct ShardInput {
+        var trackers = [TrackerData.TrackerDomain: KnownTracker]()
+        var entities = [TrackerData.EntityName: Entity]()
+        var domains = [TrackerData.TrackerDomain: TrackerData.EntityName]()
+        var cnames = [TrackerData.CnameDomain: TrackerData.TrackerDomain]()
+    }
+
+    private func makeShardInputs(trackerData: TrackerData) -> [TrackerData] {
+        var inputs = [ShardInput](repeating: ShardInput(), count: shardCount)
+        var shardForTracker = [TrackerData.TrackerDomain: Int]()
+        var shardForEntity = [TrackerData.EntityName: Int]()
+
+        for (domain, tracker) in trackerData.trackers {
+            let index = shardIndex(forEntityNamed: tracker.owner?.name ?? domain)
+            inputs[index].trackers[domain] = tracker
+            shardForTracker[domain] = index
+
+            if let entityName = tracker.owner?.name, let entity = trackerData.entities[entityName] {
+                inputs[index].entities[entityName] = entity
+                shardForEntity[entityName] = index
+            }
+        }
+
+        for (domain, entityName) in trackerData.domains {
+            guard let index = shardForEntity[entityName] else { continue }
+            inputs[index].domains[domain] = entityName
+        }
+
+        for (cname, target) in trackerData.cnames ?? [:] {
+            guard let index = shard(forHost: target, shardForTracker: shardForTracker) else { continue }
+            inputs[index].cnames[cname] = target
+        }
+
+        return inputs.map { input in
+            TrackerData(trackers: input.trackers, entities: input.entities, domains: input.domains, cnames: input.cnames)
+        }
+    }
+
+    private func shard(forHost host: String, shardForTracker: [TrackerData.TrackerDomain: Int]) -> Int? {
+        var suffix = host[...]
+        while true {
+            if let index = shardForTracker[String(suffix)] {
+                return index
+            }
+            guard let dot = suffix.firstIndex(of: ".") else { return nil }
+            suffix = suffix[suffix.index(after: dot)...]
+        }
+    }
+
+    static func concatenate(encodedArrays: [Data]) -> Data {
+        var result = Data("[".utf8)
+        var isEmpty = true
+        for array in encodedArrays {
+            let body = array.dropFirst().dropLast()
+            guard !body.isEmpty else { continue }
+            if !isEmpty {
+                result.append(UInt8(ascii: ","))
+            }
+            result.append(contentsOf: body)
+            isEmpty = false
+        }
+        result.append(UInt8(ascii: "]"))
+        return result
+    }
+
+}
+
+/// 128-bit FNV-1a, used for stable shard assignment and content digests without depending on platform crypto.
+struct FNV1a128 {
+
+    private(set) var high: UInt64 = 0x6c62272e07bb0142
+    private(set) var low: UInt64 = 0x62b821756295c58d
+
+    mutating func combine(_ string: String) {
+        combine(Data(string.utf8))
+        // Separator, so that consecutive values cannot be shifted into each other.
+        combine(byte: 0xFF)
+    }
+
+    mutating func combine(_ data: Data) {
+        for byte in data {
+            combine(byte: byte)
+        }
+    }
+
+    private mutating func combine(byte: UInt8) {
+        low ^= UInt64(byte)
+
+        // Multiply by the FNV-128 prime 2^88 + 0x13b, modulo 2^128.
+        let product = low.multipliedFullWidth(by: 0x13b)
+        let shifted = low << 24
+        high = high &* 0x13b &+ product.high &+ shifted
+        low = product.low
+    }
+
+    var hexValue: String {
+        String(format: "%016llx%016llx", high, low)
+    }
+
+}
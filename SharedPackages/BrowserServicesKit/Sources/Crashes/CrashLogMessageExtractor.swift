@@ -116,6 +116,7 @@ public struct CrashLogMessageExtractor {
     /// Install uncaught NSException and C++ exception handlers.
     /// - Parameters:
     ///   - swapCxaThrow: whether the `__cxa_throw` hook should be installed.
+    ///   - cxaThrowImageHooking: whether hooking of images outside of the main bundle should be deferred until after launch.
     /// - Note:
     ///   `__cxa_throw` is a method called under the hood when `throw MyCppException();` is executed.
     ///   It unwinds the stack to look for a `catch` handler to handle the thrown exception. If the handler can’t
@@ -130,7 +131,7 @@ public struct CrashLogMessageExtractor {
     ///
     ///   After the custom `std::terminate` or `NSUncaughtExceptionHandler` is done, we call the
     ///   original exception handler, which causes the app termination.
-    public static func setUp(swapCxaThrow: Bool = true) {
+    public static func setUp(swapCxaThrow: Bool = true, cxaThrowImageHooking: CxaThrowSwapper.ImageHooking = .immediate) {
         prepareDiagnosticsDirectory()
 
         // Set unhandled NSException handler
@@ -140,7 +141,7 @@ public struct CrashLogMessageExtractor {
         nextCppTerminateHandler = SetCxxExceptionTerminateHandler(handleTerminateOnCxxException)
         // Swap C++ `throw` to collect stack trace when throw happens
         if swapCxaThrow {
-            CxaThrowSwapper.swapCxaThrow(with: captureStackTrace)
+            CxaThrowSwapper.swapCxaThrow(with: captureStackTrace, imageHooking: cxaThrowImageHooking)
         }
     }
 
@@ -68,25 +68,128 @@
 
 import Foundation
 import Common
+import CxxCrashHandler
 import MachO
 import os.log
+import os.signpost
 
 public typealias CxaThrowType = @convention(c) (UnsafeMutableRawPointer?, UnsafeMutableRawPointer?, (@convention(c) (UnsafeMutableRawPointer?) -> Void)?) -> Void
 
 public struct CxaThrowSwapper {
 
+    public enum ImageHooking {
+        /// Every image is hooked synchronously when it’s loaded.
+        case immediate
+        /// Images outside of the main bundle (system libraries and frameworks) are hooked on the main queue after `delay`.
+        /// Exceptions thrown by these images before then won’t have their original stack trace captured.
+        case deferNonCritical(delay: TimeInterval)
+    }
+
+    /// Counters of Mach-O images processed by the `_dyld_register_func_for_add_image` callback.
+    public struct ImageProcessingStatistics: Equatable {
+        /// Images that went through the callback
+        public internal(set) var processedImageCount = 0
+        /// Images that don’t import `__cxa_throw`, filtered out by the symbol table check
+        public internal(set) var skippedImageCount = 0
+        public internal(set) var hookedImageCount = 0
+        /// Non-critical images waiting to be hooked
+        public internal(set) var deferredImageCount = 0
+        public internal(set) var failedImageCount = 0
+        /// Time spent in the callback, including processing of deferred images
+        public internal(set) var totalProcessingTime: TimeInterval = 0
+        public internal(set) var slowestImageProcessingTime: TimeInterval = 0
+    }
+
+    static let instrumentationLog = OSLog(subsystem: "com.duckduckgo.instrumentation", category: "CxaThrowSwapper")
+
     fileprivate static var cxaThrowHandler: CxaThrowType?
+    fileprivate static var deferredHookingDelay: TimeInterval?
+    fileprivate static var mainBundlePath = ""
+
+    private static let lock = NSLock()
+    private static var state = ImageProcessingState()
+
     /// Swap `__cxa_throw` (the method called when C++ `throw MyCppException();` is executed) to collect the stack trace when the throw occurs.
     /// The original exception stack trace is stored in the current NSThread dictionary and used later in the `std::terminate` handler if the exception
     /// is not caught.
-    public static func swapCxaThrow(with handler: CxaThrowType) {
+    /// - Parameters:
+    ///   - imageHooking: whether hooking of images outside of the main bundle should be moved off the app launch path.
+    public static func swapCxaThrow(with handler: CxaThrowType, imageHooking: ImageHooking = .immediate) {
         dispatchPrecondition(condition: .onQueue(.main))
-        if cxaThrowHandler == nil {
-            // iterate through mach headers loaded in memory and hook `__cxa_throw` method by overwriting its address.
-            // When this function is first registered, it is called once for each image that is currently part of the process.
-            _dyld_register_func_for_add_image(processMachHeader)
-        }
+        let isFirstCall = cxaThrowHandler == nil
         cxaThrowHandler = handler
+        guard isFirstCall else { return }
+
+        mainBundlePath = Bundle.main.bundlePath
+        if case .deferNonCritical(let delay) = imageHooking {
+            deferredHookingDelay = delay
+        }
+
+        let signpostID = OSSignpostID(log: instrumentationLog)
+        os_signpost(.begin, log: instrumentationLog, name: "Swap __cxa_throw", signpostID: signpostID)
+        if deferredHookingDelay != nil {
+            // deferred images unloaded before they are hooked must not be touched
+            _dyld_register_func_for_remove_image(removeMachHeader)
+        }
+        // iterate through mach headers loaded in memory and hook `__cxa_throw` method by overwriting its address.
+        // When this function is first registered, it is called once for each image that is currently part of the process.
+        _dyld_register_func_for_add_image(processMachHeader)
+        let statistics = imageProcessingStatistics
+        os_signpost(.end, log: instrumentationLog, name: "Swap __cxa_throw", signpostID: signpostID,
+                    "processed: %ld, hooked: %ld, deferred: %ld", statistics.processedImageCount, statistics.hookedImageCount, statistics.deferredImageCount)
+    }
+
+    /// Hook images deferred by the `.deferNonCritical` image hooking without waiting for the delay to pass.
+    public static func hookDeferredImages() {
+        dispatchPrecondition(condition: .onQueue(.main))
+        lock.lock()
+        let images = state.takeDeferredImages()
+        lock.unlock()
+
+        for image in images {
+            processImage(header: image.header, slide: image.slide, isDeferred: true)
+        }
+    }
+
+    public static var imageProcessingStatistics: ImageProcessingStatistics {
+        lock.lock(); defer { lock.unlock() }
+        return state.statistics
+    }
+
+    fileprivate static func processImage(header: UnsafePointer<mach_header_64>?, slide: Int, isDeferred: Bool) {
+        let signpostID = OSSignpostID(log: instrumentationLog)
+        os_signpost(.begin, log: instrumentationLog, name: "Process Image", signpostID: signpostID, "%{public}@", header.debugDescription)
+        let start = DispatchTime.now().uptimeNanoseconds
+
+        let result: ImageProcessingResult
+        do {
+            result = try _processMachHeader(header, slide: slide, canDefer: !isDeferred && deferredHookingDelay != nil)
+        } catch {
+            Logger.general.error("mach header \(header.debugDescription) processing error: \(error.localizedDescription)")
+            result = .failed
+        }
+
+        let duration = TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / TimeInterval(NSEC_PER_SEC)
+        lock.lock()
+        let shouldScheduleDeferredHooking = state.record(result, duration: duration, header: header, slide: slide, isDeferred: isDeferred)
+        lock.unlock()
+        os_signpost(.end, log: instrumentationLog, name: "Process Image", signpostID: signpostID, "%{public}@", result.rawValue)
+
+        if shouldScheduleDeferredHooking, let delay = deferredHookingDelay {
+            DispatchQueue.main.asyncAfter(deadline: .now() + delay) {
+                hookDeferredImages()
+            }
+        }
+    }
+
+    fileprivate static func removeImage(header: UnsafePointer<mach_header_64>) {
+        lock.lock(); defer { lock.unlock() }
+        state.removeDeferredImage(header: header)
+    }
+
+    fileprivate static func isCritical(_ header: UnsafePointer<mach_header_64>) -> Bool {
+        guard let headerInfo = try? Dl_info(header), let path = headerInfo.dli_fname else { return true }
+        return String(cString: path).hasPrefix(mainBundlePath)
     }
 
 }
@@ -103,70 +206,144 @@ private enum ProcessingError: LocalizedError {
     }
 }
 
+enum ImageProcessingResult: String {
+    case skipped
+    case hooked
+    case deferred
+    case failed
+}
+
+/// Image processing statistics and images queued by the `.deferNonCritical` image hooking; not thread-safe.
+struct ImageProcessingState {
+    private(set) var statistics = CxaThrowSwapper.ImageProcessingStatistics()
+    private(set) var deferredImages = [(header: UnsafePointer<mach_header_64>, slide: Int)]()
+
+    /// - Returns: whether hooking of deferred images should be scheduled
+    mutating func record(_ result: ImageProcessingResult,
+                         duration: TimeInterval,
+                         header: UnsafePointer<mach_header_64>?,
+                         slide: Int,
+                         isDeferred: Bool) -> Bool {
+        if !isDeferred {
+            statistics.processedImageCount += 1
+        }
+        switch result {
+        case .skipped: statistics.skippedImageCount += 1
+        case .hooked: statistics.hookedImageCount += 1
+        case .failed: statistics.failedImageCount += 1
+        case .deferred:
+            statistics.deferredImageCount += 1
+            // header can’t be nil for a deferred image
+            deferredImages.append((header!, slide))
+        }
+        if isDeferred {
+            statistics.deferredImageCount -= 1
+        }
+        statistics.totalProcessingTime += duration
+        statistics.slowestImageProcessingTime = max(statistics.slowestImageProcessingTime, duration)
+        return result == .deferred && deferredImages.count == 1
+    }
+
+    mutating func takeDeferredImages() -> [(header: UnsafePointer<mach_header_64>, slide: Int)] {
+        defer { deferredImages.removeAll() }
+        return deferredImages
+    }
+
+    /// Forget a deferred image that has been unloaded before it was hooked
+    mutating func removeDeferredImage(header: UnsafePointer<mach_header_64>) {
+        guard let index = deferredImages.firstIndex(where: { $0.header == header }) else { return }
+        deferredImages.remove(at: index)
+        statistics.deferredImageCount -= 1
+    }
+}
+
 // _dyld_register_func_for_add_image callback
 private func processMachHeader(_ header: UnsafePointer<mach_header>?, slide: Int) {
-    do {
-        try _processMachHeader(header.map(UnsafeRawPointer.init)?.assumingMemoryBound(to: mach_header_64.self), slide: slide)
-    } catch {
-        Logger.general.error("mach header \(header.debugDescription) processing error: \(error.localizedDescription)")
-    }
+    CxaThrowSwapper.processImage(header: header.map(UnsafeRawPointer.init)?.assumingMemoryBound(to: mach_header_64.self), slide: slide, isDeferred: false)
 }
 
+// _dyld_register_func_for_remove_image callback
+private func removeMachHeader(_ header: UnsafePointer<mach_header>?, slide: Int) {
+    guard let header = header.map(UnsafeRawPointer.init)?.assumingMemoryBound(to: mach_header_64.self) else { return }
+    CxaThrowSwapper.removeImage(header: header)
+}
+
+// Original `__cxa_throw` function pointers by image header address.
+// Images may be hooked from any thread loading them, while throws are handled on any other thread.
 private var cxxOriginalThrowFunctions = [UnsafeRawPointer: UnsafeRawPointer]()
+private let cxxOriginalThrowFunctionsLock = NSLock()
 private let indicesToSkip = [UInt32(INDIRECT_SYMBOL_ABS), INDIRECT_SYMBOL_LOCAL, INDIRECT_SYMBOL_LOCAL | UInt32(INDIRECT_SYMBOL_ABS)]
 
-private func _processMachHeader(_ header: UnsafePointer<mach_header_64>?, slide: Int) throws {
+private func _processMachHeader(_ header: UnsafePointer<mach_header_64>?, slide: Int, canDefer: Bool) throws -> ImageProcessingResult {
     guard let header, slide != 0 else { throw ProcessingError.zeroSlide }
-    let headerInfo = try Dl_info(header)
-    Logger.general.debug("processing image \(String(cString: headerInfo.dli_fname)) (\(header.debugDescription), slide: \(slide)")
 
     // Lookup for the needed Mach-O loader commands and segments.
     guard let imageMap = ImageMap(header: header, slide: slide) else { throw ProcessingError.imageMap }
 
-    try processSegment(imageMap.dataSegment)
-    try processSegment(imageMap.dataConstSegment)
+    // Most images don’t import `__cxa_throw`: checking the undefined symbols is much cheaper than
+    // walking every symbol pointer section (and changing memory protection of each).
+    guard imageMap.importsSymbol(named: "___cxa_throw") else { return .skipped }
+
+    if canDefer, !CxaThrowSwapper.isCritical(header) {
+        return .deferred
+    }
+    Logger.general.debug("processing image \(header.debugDescription) (slide: \(slide))")
+
+    // `__cxa_throw` may be bound in more than one symbol pointer section (e.g. both lazy and non-lazy), so every slot is patched.
+    var isHooked = false
+    for segment in [imageMap.dataSegment, imageMap.dataConstSegment] {
+        if try processSegment(segment) {
+            isHooked = true
+        }
+    }
+    return isHooked ? .hooked : .skipped
 
-    func processSegment(_ segment: UnsafePointer<segment_command_64>?) throws {
-        guard let segment else { return }
+    /// - Returns: whether any `__cxa_throw` slot was patched in the segment
+    func processSegment(_ segment: UnsafePointer<segment_command_64>?) throws -> Bool {
+        guard let segment else { return false }
+        var isPatched = false
         let sections = segment.sections
         for section in sections.baseAddress!..<sections.baseAddress!.advanced(by: sections.count)
         where [S_LAZY_SYMBOL_POINTERS, S_NON_LAZY_SYMBOL_POINTERS].contains(section.pointee.type) {
 
-            try section.pointee.indirectSymbolBindings(slide: slide)?.withTemporaryUnprotectedMemory { indirectSymbolBindings in
-                guard let indirectSymbolIndices = section.pointee.indirectSymbolIndices(indirectSymtab: imageMap.indirectSymtab) else { return }
-                // Iterate symbols in the section of the __DATA or __DATA_CONST segments.
-                for i in 0..<section.pointee.count where indirectSymbolIndices.indices.contains(i) && indirectSymbolBindings.indices.contains(i) {
-                    let symtabIndex = indirectSymbolIndices[i]
-                    guard !indicesToSkip.contains(symtabIndex),
-                          let symbolName = imageMap.symbolName(at: Int(symtabIndex)),
-                          // There were crashes when the String(cString:) constructor was used for some C string pointers,
-                          // which was probably caused by the `0`-terminating character lookup getting out of the `strtab` buffer bounds.
-                          // This implementation matches the original KSCrash code using strcmp (bytewise compare); it doesn’t copy
-                          // the original C String buffer and stops at the first non-matching byte.
-                          // - First, we make sure the string is not empty and is longer than 1 byte.
-                          symbolName[0] != 0, symbolName[1] != 0,
-                          // Then we skip the first "_" character and compare.
-                          strcmp(symbolName.advanced(by: 1), "__cxa_throw") == 0 else { continue }
-
-                    let sectionInfo = try Dl_info(section)
-                    Logger.general.debug("found \(String(cString: symbolName)): \(indirectSymbolBindings[i].debugDescription)")
-
-                    // Now that the `__cxa_throw` symbol index is found, the magique begins:
-                    // - We store the original function pointer from the section’s indirect symbol bindings table in the
-                    //   `cxxOriginalThrowFunctions` dictionary by the base address of the section.
-                    // - Since the `__cxa_throw` method is compiler-generated, it is present in each Mach-O binary loaded by the app.
-                    //   That’s why we may need to hook it several times.
-                    cxxOriginalThrowFunctions[UnsafeRawPointer(sectionInfo.dli_fbase)] = indirectSymbolBindings[i]
-                    // - Now we overwrite the function pointer directly in the section memory with our custom handler,
-                    //   so the next time `throw Exception();` is called, it will call our handler first. Then
-                    //   we will find the original `__cxa_throw` method using the base address of the section that is
-                    //   passed as the `tinfo` parameter into our custom handler.
-                    indirectSymbolBindings[i] = unsafeBitCast(cxaThrowHandler as CxaThrowType, to: UnsafeRawPointer.self)
+            guard let indirectSymbolBindings = section.pointee.indirectSymbolBindings(slide: slide),
+                  let indirectSymbolIndices = section.pointee.indirectSymbolIndices(indirectSymtab: imageMap.indirectSymtab) else { continue }
+            // Iterate symbols in the section of the __DATA or __DATA_CONST segments.
+            for i in 0..<section.pointee.count where indirectSymbolIndices.indices.contains(i) && indirectSymbolBindings.indices.contains(i) {
+                let symtabIndex = indirectSymbolIndices[i]
+                guard !indicesToSkip.contains(symtabIndex),
+                      let symbolName = imageMap.symbolName(at: Int(symtabIndex)),
+                      // There were crashes when the String(cString:) constructor was used for some C string pointers,
+                      // which was probably caused by the `0`-terminating character lookup getting out of the `strtab` buffer bounds.
+                      // This implementation matches the original KSCrash code using strcmp (bytewise compare); it doesn’t copy
+                      // the original C String buffer and stops at the first non-matching byte.
+                      // - First, we make sure the string is not empty and is longer than 1 byte.
+                      symbolName[0] != 0, symbolName[1] != 0,
+                      // Then we skip the first "_" character and compare.
+                      strcmp(symbolName.advanced(by: 1), "__cxa_throw") == 0 else { continue }
 
-                    break
+                Logger.general.debug("found \(String(cString: symbolName)): \(indirectSymbolBindings[i].debugDescription)")
+
+                // Now that the `__cxa_throw` symbol index is found, the magique begins:
+                // - We store the original function pointer from the section’s indirect symbol bindings table in the
+                //   `cxxOriginalThrowFunctions` dictionary by the image header address.
+                // - Since the `__cxa_throw` method is compiler-generated, it is present in each Mach-O binary loaded by the app.
+                //   That’s why we may need to hook it several times.
+                cxxOriginalThrowFunctionsLock.lock()
+                cxxOriginalThrowFunctions[UnsafeRawPointer(header)] = indirectSymbolBindings[i]
+                cxxOriginalThrowFunctionsLock.unlock()
+                // - Now we overwrite the function pointer directly in the section memory with our custom handler,
+                //   so the next time `throw Exception();` is called, it will call our handler first. Then
+                //   we will find the original `__cxa_throw` method using the base address of the image the caller belongs to.
+                // Memory protection is only changed for the section that is actually being patched.
+                try indirectSymbolBindings.withTemporaryUnprotectedMemory { indirectSymbolBindings in
+                    indirectSymbolBindings[i] = unsafeBitCast(cxaThrowHandler as CxaThrowType, to: UnsafeRawPointer.self)
                 }
+
+                isPatched = true
             }
         }
+        return isPatched
     }
 }
 
@@ -175,6 +352,7 @@ private func cxaThrowHandler(thrownException: UnsafeMutableRawPointer?, tinfo: U
     let kRequiredFrames = 2
 
     Logger.general.debug("handling __cxa_throw")
+    recordCxxThrow(tinfo)
     CxaThrowSwapper.cxaThrowHandler?(thrownException, tinfo, dest)
 
     var backtraceArr = [UnsafeMutableRawPointer?](repeating: nil, count: kRequiredFrames)
@@ -182,8 +360,12 @@ private func cxaThrowHandler(thrownException: UnsafeMutableRawPointer?, tinfo: U
 
     if count >= kRequiredFrames {
         var info = Dl_info()
-        if dladdr(backtraceArr[kRequiredFrames - 1], &info) != 0 {
-            if let function = cxxOriginalThrowFunctions[info.dli_fbase] {
+        if dladdr(backtraceArr[kRequiredFrames - 1], &info) != 0,
+           let imageBase = info.dli_fbase.map(UnsafeRawPointer.init) {
+            cxxOriginalThrowFunctionsLock.lock()
+            let function = cxxOriginalThrowFunctions[imageBase]
+            cxxOriginalThrowFunctionsLock.unlock()
+            if let function {
                 Logger.general.debug("calling original __cxa_throw function at \(function.debugDescription)")
                 let original = unsafeBitCast(function, to: CxaThrowType.self)
                 original(thrownException, tinfo, dest)
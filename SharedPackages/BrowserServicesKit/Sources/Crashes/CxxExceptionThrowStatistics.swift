@@ -0,0 +1,146 @@
+//
+//  CxxExceptionThrowStatistics.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Common
+import CxxCrashHandler
+import Foundation
+
+/// Counts of C++ exceptions thrown in the process, by exception type, with a histogram of sampled throw call stacks.
+///
+/// Throws are counted in the `__cxa_throw` hook, so statistics are only collected for images hooked by `CxaThrowSwapper`
+/// (see `CrashLogMessageExtractor.setUp(swapCxaThrow:)`). Counters are cumulative for the process lifetime;
+/// use `Snapshot.subtracting(_:)` to get the throws that happened between two snapshots.
+public enum CxxExceptionThrowStatistics {
+
+    public enum Event {
+        case cxxExceptionThrows
+    }
+
+    public struct StackSample: Equatable {
+        /// Return addresses, starting at the frame that executed `throw`
+        public let addresses: [UInt]
+        public let count: UInt64
+
+        /// `image symbol + offset` for each of the addresses
+        public var symbols: [String] {
+            addresses.map { address in
+                var info = Dl_info()
+                guard let pointer = UnsafeRawPointer(bitPattern: address), dladdr(pointer, &info) != 0 else {
+                    return String(format: "0x%lx", address)
+                }
+                let image = info.dli_fname.map { URL(fileURLWithPath: String(cString: $0)).lastPathComponent } ?? "???"
+                guard let symbol = info.dli_sname, let symbolAddress = info.dli_saddr else {
+                    return "\(image) " + String(format: "0x%lx", address)
+                }
+                return "\(image) \(String(cString: symbol)) + \(address - UInt(bitPattern: symbolAddress))"
+            }
+        }
+    }
+
+    public struct Snapshot: Equatable {
+        /// Throw counts by demangled exception type name
+        public let throwCounts: [String: UInt64]
+        /// Sampled throw call stacks, most frequent first
+        public let stackSamples: [StackSample]
+
+        public var totalCount: UInt64 {
+            throwCounts.values.reduce(0, +)
+        }
+
+        /// Exception types sorted by throw count, most frequent first
+        public func topTypes(_ limit: Int) -> [(typeName: String, count: UInt64)] {
+            throwCounts.sorted { $0.value > $1.value || ($0.value == $1.value && $0.key < $1.key) }
+                .prefix(limit)
+                .map { ($0.key, $0.value) }
+        }
+
+        /// Throws that happened after the `previous` snapshot was taken
+        public func subtracting(_ previous: Snapshot) -> Snapshot {
+            let throwCounts = self.throwCounts.reduce(into: [String: UInt64]()) { result, entry in
+                let count = entry.value - min(entry.value, previous.throwCounts[entry.key] ?? 0)
+                if count > 0 {
+                    result[entry.key] = count
+                }
+            }
+            let previousStackCounts = Dictionary(previous.stackSamples.map { ($0.addresses, $0.count) }, uniquingKeysWith: +)
+            let stackSamples = self.stackSamples.compactMap { sample -> StackSample? in
+                let count = sample.count - min(sample.count, previousStackCounts[sample.addresses] ?? 0)
+                return count > 0 ? StackSample(addresses: sample.addresses, count: count) : nil
+            }
+            return Snapshot(throwCounts: throwCounts, stackSamples: stackSamples)
+        }
+
+        /// Human-readable report for debug menus and logs
+        public var debugDescription: String {
+            var lines = ["C++ exceptions thrown: \(totalCount)"]
+            for (typeName, count) in topTypes(throwCounts.count) {
+                lines.append("  \(count)\t\(typeName)")
+            }
+            for (index, sample) in stackSamples.enumerated() {
+                lines.append("Sampled stack #\(index + 1) (\(sample.count) samples):")
+                lines.append(contentsOf: sample.symbols.map { "    " + $0 })
+            }
+            return lines.joined(separator: "\n")
+        }
+    }
+
+    /// Whether throws are being counted (disabled by default)
+    public static var isEnabled: Bool {
+        get { IsCxxThrowStatisticsEnabled() }
+        set { SetCxxThrowStatisticsEnabled(newValue) }
+    }
+
+    /// Every n-th throw on each thread has its call stack sampled; `0` disables stack sampling
+    public static var stackSamplingInterval: UInt32 {
+        get { GetCxxThrowStackSamplingInterval() }
+        set { SetCxxThrowStackSamplingInterval(newValue) }
+    }
+
+    /// Aggregate counters of all threads
+    public static func snapshot() -> Snapshot {
+        var throwCounts = [String: UInt64]()
+        EnumerateCxxThrowCounts { typeName, count in
+            throwCounts[String(cString: typeName), default: 0] += count
+        }
+
+        var stackSamples = [StackSample]()
+        EnumerateCxxThrowStackSamples { frames, frameCount, count in
+            let addresses = UnsafeBufferPointer(start: frames, count: frameCount).map { UInt(bitPattern: $0) }
+            stackSamples.append(StackSample(addresses: addresses, count: count))
+        }
+        stackSamples.sort { $0.count > $1.count }
+
+        return Snapshot(throwCounts: throwCounts, stackSamples: stackSamples)
+    }
+
+    /// Fire the `cxxExceptionThrows` event with throws counted since the `previous` snapshot, if there were any.
+    /// - Returns: the current snapshot, to be passed as `previous` next time
+    @discardableResult
+    public static func fireStatisticsPixel(since previous: Snapshot?, using pixelEvents: EventMapping<Event>, topTypesLimit: Int = 5) -> Snapshot {
+        let current = snapshot()
+        let statistics = previous.map(current.subtracting) ?? current
+        guard statistics.totalCount > 0 else { return current }
+
+        pixelEvents.fire(.cxxExceptionThrows, parameters: [
+            "count": String(statistics.totalCount),
+            "types": statistics.topTypes(topTypesLimit).map { "\($0.typeName):\($0.count)" }.joined(separator: ",")
+        ])
+        return current
+    }
+
+}
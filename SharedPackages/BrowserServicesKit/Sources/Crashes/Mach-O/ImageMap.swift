@@ -95,4 +95,17 @@ struct ImageMap {
         return symbolName
     }
 
+    /// Check whether the image imports an external symbol, e.g. `___cxa_throw`.
+    /// - Note: Only the undefined symbols range of the symbol table is walked, without touching the symbol pointer sections.
+    func importsSymbol(named name: UnsafePointer<CChar>) -> Bool {
+        let firstIndex = Int(dysymtabCmd.iundefsym)
+        for symtabIndex in firstIndex..<(firstIndex + Int(dysymtabCmd.nundefsym)) {
+            guard let symbolName = symbolName(at: symtabIndex) else { continue }
+            if strcmp(symbolName, name) == 0 {
+                return true
+            }
+        }
+        return false
+    }
+
 }
@@ -0,0 +1,276 @@
+//
+//  CxxThrowStatistics.mm
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "CxxThrowStatistics.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <map>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+
+const size_t kTypeSlotCount = 64;
+const size_t kStackSlotCount = 32;
+const size_t kMaxStackFrames = 16;
+// `recordCxxThrow` and the `__cxa_throw` hook; `sampleStackIfNeeded` is always inlined into `recordCxxThrow`
+const int kSkippedStackFrames = 2;
+const char *kOtherTypeName = "<other>";
+
+struct TypeSlot {
+    std::atomic<const std::type_info *> type;
+    std::atomic<uint64_t> count;
+};
+
+struct StackSlot {
+    // `0` until the frames are written, published with release ordering
+    std::atomic<uint64_t> hash;
+    std::atomic<uint64_t> count;
+    size_t frameCount;
+    void *frames[kMaxStackFrames];
+};
+
+// Counters are only written by the thread owning the table and read by any thread aggregating them.
+// Tables are never freed: when a thread exits, its table is handed over to the next new thread with its counts intact.
+struct ThreadTable {
+    std::atomic<bool> inUse;
+    ThreadTable *next;
+    uint32_t throwsUntilNextSample;
+    std::atomic<uint64_t> otherTypesCount;
+    TypeSlot types[kTypeSlotCount];
+    StackSlot stacks[kStackSlotCount];
+};
+
+std::atomic<ThreadTable *> threadTables(nullptr);
+std::atomic<bool> isEnabled(false);
+std::atomic<uint32_t> stackSamplingInterval(64);
+
+// Trivially destructible, so it stays valid while other thread-local destructors run and throw.
+thread_local bool isThreadTableOwnerDestroyed = false;
+
+struct ThreadTableOwner {
+    ThreadTable *table = nullptr;
+
+    ~ThreadTableOwner() {
+        isThreadTableOwnerDestroyed = true;
+        if (table) {
+            table->inUse.store(false, std::memory_order_release);
+            // The table may be claimed by another thread from now on.
+            table = nullptr;
+        }
+    }
+};
+
+thread_local ThreadTableOwner threadTableOwner;
+
+ThreadTable *claimThreadTable() {
+    for (ThreadTable *table = threadTables.load(std::memory_order_acquire); table; table = table->next) {
+        bool inUse = false;
+        if (table->inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire)) {
+            return table;
+        }
+    }
+
+    ThreadTable *table = new (std::nothrow) ThreadTable();
+    if (!table) {
+        return nullptr;
+    }
+    table->inUse.store(true, std::memory_order_relaxed);
+    ThreadTable *head = threadTables.load(std::memory_order_relaxed);
+    do {
+        table->next = head;
+    } while (!threadTables.compare_exchange_weak(head, table, std::memory_order_release, std::memory_order_relaxed));
+    return table;
+}
+
+// single writer: no read-modify-write needed
+inline void increment(std::atomic<uint64_t> &counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void countType(ThreadTable *table, const std::type_info *type) {
+    if (type) {
+        size_t index = (reinterpret_cast<uintptr_t>(type) >> 4) % kTypeSlotCount;
+        for (size_t probe = 0; probe < kTypeSlotCount; probe++) {
+            TypeSlot &slot = table->types[(index + probe) % kTypeSlotCount];
+            const std::type_info *slotType = slot.type.load(std::memory_order_relaxed);
+            if (slotType == type) {
+                increment(slot.count);
+                return;
+            }
+            if (!slotType) {
+                slot.count.store(1, std::memory_order_relaxed);
+                slot.type.store(type, std::memory_order_release);
+                return;
+            }
+        }
+    }
+    increment(table->otherTypesCount);
+}
+
+void countStack(ThreadTable *table, void * const *frames, size_t frameCount) {
+    // FNV-1a over the return addresses
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < frameCount; i++) {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ULL;
+    }
+    hash |= 1;
+
+    for (size_t probe = 0; probe < kStackSlotCount; probe++) {
+        StackSlot &slot = table->stacks[(hash + probe) % kStackSlotCount];
+        uint64_t slotHash = slot.hash.load(std::memory_order_relaxed);
+        if (slotHash == hash && slot.frameCount == frameCount && memcmp(slot.frames, frames, frameCount * sizeof(void *)) == 0) {
+            increment(slot.count);
+            return;
+        }
+        if (slotHash == 0) {
+            memcpy(slot.frames, frames, frameCount * sizeof(void *));
+            slot.frameCount = frameCount;
+            slot.count.store(1, std::memory_order_relaxed);
+            slot.hash.store(hash, std::memory_order_release);
+            return;
+        }
+    }
+    // the histogram is full: the most frequent stacks are usually the first ones to be sampled
+}
+
+__attribute__((always_inline)) inline void sampleStackIfNeeded(ThreadTable *table) {
+    uint32_t interval = stackSamplingInterval.load(std::memory_order_relaxed);
+    if (interval == 0) {
+        return;
+    }
+    // the interval may have been lowered since the countdown started
+    if (table->throwsUntilNextSample > interval - 1) {
+        table->throwsUntilNextSample = interval - 1;
+    }
+    if (table->throwsUntilNextSample > 0) {
+        table->throwsUntilNextSample--;
+        return;
+    }
+    table->throwsUntilNextSample = interval - 1;
+
+    void *frames[kMaxStackFrames + kSkippedStackFrames];
+    int count = backtrace(frames, (int)(kMaxStackFrames + kSkippedStackFrames));
+    if (count > kSkippedStackFrames) {
+        countStack(table, frames + kSkippedStackFrames, (size_t)(count - kSkippedStackFrames));
+    }
+}
+
+std::string demangledName(const std::type_info *type) {
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(type->name(), nullptr, nullptr, &status);
+    if (!demangled) {
+        return type->name();
+    }
+    std::string name(demangled);
+    free(demangled);
+    return name;
+}
+
+} // namespace
+
+extern "C" void SetCxxThrowStatisticsEnabled(bool enabled) {
+    isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+extern "C" bool IsCxxThrowStatisticsEnabled(void) {
+    return isEnabled.load(std::memory_order_relaxed);
+}
+
+extern "C" void SetCxxThrowStackSamplingInterval(uint32_t interval) {
+    stackSamplingInterval.store(interval, std::memory_order_relaxed);
+}
+
+extern "C" uint32_t GetCxxThrowStackSamplingInterval(void) {
+    return stackSamplingInterval.load(std::memory_order_relaxed);
+}
+
+extern "C" void recordCxxThrow(void* tinfo) __attribute__((disable_tail_calls)) {
+    if (!isEnabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    // Throws from thread-local destructors running after the owner's would claim a table that is never released.
+    if (isThreadTableOwnerDestroyed) {
+        return;
+    }
+    ThreadTable *table = threadTableOwner.table;
+    if (!table) {
+        table = claimThreadTable();
+        if (!table) {
+            return;
+        }
+        threadTableOwner.table = table;
+    }
+
+    countType(table, static_cast<const std::type_info *>(tinfo));
+    sampleStackIfNeeded(table);
+
+    __asm__ __volatile__(""); // thwart tail-call optimization
+}
+
+extern "C" void EnumerateCxxThrowCounts(void (^block)(const char *typeName, uint64_t count)) {
+    std::map<const std::type_info *, uint64_t> countsByType;
+    uint64_t otherTypesCount = 0;
+
+    for (ThreadTable *table = threadTables.load(std::memory_order_acquire); table; table = table->next) {
+        for (size_t i = 0; i < kTypeSlotCount; i++) {
+            const std::type_info *type = table->types[i].type.load(std::memory_order_acquire);
+            if (type) {
+                countsByType[type] += table->types[i].count.load(std::memory_order_relaxed);
+            }
+        }
+        otherTypesCount += table->otherTypesCount.load(std::memory_order_relaxed);
+    }
+
+    // the same type may have several `type_info` instances, one per image
+    std::map<std::string, uint64_t> countsByName;
+    for (const auto &entry : countsByType) {
+        countsByName[demangledName(entry.first)] += entry.second;
+    }
+    if (otherTypesCount > 0) {
+        countsByName[kOtherTypeName] += otherTypesCount;
+    }
+
+    for (const auto &entry : countsByName) {
+        block(entry.first.c_str(), entry.second);
+    }
+}
+
+extern "C" void EnumerateCxxThrowStackSamples(void (^block)(const void * const *frames, size_t frameCount, uint64_t count)) {
+    std::map<std::vector<const void *>, uint64_t> countsByStack;
+
+    for (ThreadTable *table = threadTables.load(std::memory_order_acquire); table; table = table->next) {
+        for (size_t i = 0; i < kStackSlotCount; i++) {
+            const StackSlot &slot = table->stacks[i];
+            if (slot.hash.load(std::memory_order_acquire) == 0) {
+                continue;
+            }
+            std::vector<const void *> frames(slot.frames, slot.frames + slot.frameCount);
+            countsByStack[frames] += slot.count.load(std::memory_order_relaxed);
+        }
+    }
+
+    for (const auto &entry : countsByStack) {
+        block(entry.first.data(), entry.first.size(), entry.second);
+    }
+}
@@ -17,9 +17,11 @@
 //
 
 #include "TestException.h"
+#include "CxxThrowStatistics.h"
 
 #include <stdexcept>
 #include <string>
+#include <typeinfo>
 
 class TestException : public std::exception {
 public:
@@ -35,3 +37,7 @@ private:
 extern "C" void _throwTestCppException(NSString *message) {
     throw TestException(std::string([message UTF8String]));
 }
+
+extern "C" void _recordTestCppExceptionThrow(void) {
+    recordCxxThrow((void *)&typeid(TestException));
+}
@@ -18,5 +18,6 @@
 
 #pragma once
 
+#include <CxxThrowStatistics.h>
 #include <NSException+cxxHandler.h>
 #include <TestException.h>
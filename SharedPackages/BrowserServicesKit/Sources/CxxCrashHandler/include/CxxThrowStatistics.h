@@ -0,0 +1,56 @@
+//
+//  CxxThrowStatistics.h
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef CxxThrowStatistics_h
+#define CxxThrowStatistics_h
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Enable or disable counting of C++ throws in the `std::__cxa_throw` hook (disabled by default)
+void SetCxxThrowStatisticsEnabled(bool enabled);
+bool IsCxxThrowStatisticsEnabled(void);
+
+/// Capture the raw call stack of every `interval`-th throw on each thread (64 by default, `0` disables stack sampling)
+void SetCxxThrowStackSamplingInterval(uint32_t interval);
+uint32_t GetCxxThrowStackSamplingInterval(void);
+
+/// Count a C++ throw of the `std::type_info` type when handling `std::__cxa_throw` hook
+/// - Note: Counters are kept in per-thread tables written only by their owning thread, so recording takes no locks
+///   and doesn’t allocate after the first throw on a thread.
+void recordCxxThrow(void* _Nullable tinfo) __attribute__((disable_tail_calls));
+
+/// Aggregate throw counters of all threads by demangled exception type name
+/// - Note: Throws of types that didn’t fit in the per-thread tables are reported under the `"<other>"` name.
+void EnumerateCxxThrowCounts(void (NS_NOESCAPE ^block)(const char *typeName, uint64_t count));
+
+/// Aggregate sampled throw call stacks of all threads, starting at the frame that executed `throw`
+void EnumerateCxxThrowStackSamples(void (NS_NOESCAPE ^block)(const void * _Nonnull const * _Nonnull frames, size_t frameCount, uint64_t count));
+
+#ifdef __cplusplus
+}
+#endif
+
+NS_ASSUME_NONNULL_END
+
+#endif // CxxThrowStatistics_h
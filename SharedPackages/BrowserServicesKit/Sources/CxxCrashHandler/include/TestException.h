@@ -28,6 +28,9 @@ extern "C" {
 /// Throw C++ test exception with the provided message (used for debug purpose)
 void _throwTestCppException(NSString *message);
 
+/// Record a throw of the C++ test exception in the throw statistics without throwing it (used for debug purpose)
+void _recordTestCppExceptionThrow(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -270,6 +270,33 @@ public protocol Crypting {
      * is preferred.
      */
     func base64DecodeAndDecrypt(_ value: String) throws -> String
+
+    /**
+     * Encrypts `values` using provided `secretKey` and encodes them using Base64 encoding.
+     *
+     * Values are processed concurrently in chunks and results are returned in the order of `values`.
+     * A value that cannot be encrypted gets a failure result, without affecting the other values.
+     */
+    func encryptAndBase64Encode(_ values: [String], using secretKey: Data) -> [Result<String, Error>]
+
+    /**
+     * Decodes Base64-encoded `values` and decrypts them using provided `secretKey`.
+     *
+     * Values are processed concurrently in chunks and results are returned in the order of `values`.
+     * A value that cannot be decoded or decrypted gets a failure result, without affecting the other values.
+     */
+    func base64DecodeAndDecrypt(_ values: [String], using secretKey: Data) -> [Result<String, Error>]
+}
+
+public extension Crypting {
+
+    func encryptAndBase64Encode(_ values: [String], using secretKey: Data) -> [Result<String, Error>] {
+        values.map { value in Result { try encryptAndBase64Encode(value, using: secretKey) } }
+    }
+
+    func base64DecodeAndDecrypt(_ values: [String], using secretKey: Data) -> [Result<String, Error>] {
+        values.map { value in Result { try base64DecodeAndDecrypt(value, using: secretKey) } }
+    }
 }
 
 public protocol RemoteConnecting {
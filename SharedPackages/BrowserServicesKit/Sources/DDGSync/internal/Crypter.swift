@@ -78,6 +78,113 @@ struct Crypter: CryptingInternal {
         return decryptedValue
     }
 
+    // MARK: - Batch operations
+
+    /// Number of values processed by a single unit of work in batch operations.
+    static let batchChunkSize = 256
+
+    func encryptAndBase64Encode(_ values: [String], using secretKey: Data) -> [Result<String, Error>] {
+        let encryptionKey: [UInt8] = secretKey.safeBytes
+        assert(encryptionKey.count == Int(DDGSYNCCRYPTO_SECRET_KEY_SIZE.rawValue) ||
+               encryptionKey.count == Int(DDGSYNCCRYPTO_PRIMARY_KEY_SIZE.rawValue))
+        let extraBytesSize = Int(DDGSYNCCRYPTO_ENCRYPTED_EXTRA_BYTES_SIZE.rawValue)
+
+        return performInChunks(count: values.count) { range in
+            var key = encryptionKey
+            // Holds raw bytes followed by encrypted bytes, reused for every value in the chunk.
+            var arena = [UInt8]()
+
+            return range.map { index in
+                Result<String, Error> {
+                    let value = values[index]
+                    let rawCount = value.utf8.count
+                    let requiredCount = 2 * rawCount + extraBytesSize
+                    if arena.count < requiredCount {
+                        arena = [UInt8](repeating: 0, count: max(requiredCount, 2 * arena.count))
+                    }
+
+                    return try arena.withUnsafeMutableBufferPointer { buffer in
+                        _ = UnsafeMutableBufferPointer(rebasing: buffer[0..<rawCount]).initialize(from: value.utf8)
+                        let rawBytes = buffer.baseAddress!
+                        let encryptedBytes = rawBytes + rawCount
+
+                        let result = ddgSyncEncrypt(encryptedBytes, rawBytes, UInt64(rawCount), &key)
+                        guard DDGSYNCCRYPTO_OK == result else {
+                            throw SyncError.failedToEncryptValue("ddgSyncEncrypt failed: \(result)")
+                        }
+                        return Data(bytesNoCopy: encryptedBytes, count: rawCount + extraBytesSize, deallocator: .none).base64EncodedString()
+                    }
+                }
+            }
+        }
+    }
+
+    func base64DecodeAndDecrypt(_ values: [String], using secretKey: Data) -> [Result<String, Error>] {
+        let decryptionKey: [UInt8] = secretKey.safeBytes
+        assert(decryptionKey.count == Int(DDGSYNCCRYPTO_SECRET_KEY_SIZE.rawValue) ||
+               decryptionKey.count == Int(DDGSYNCCRYPTO_PRIMARY_KEY_SIZE.rawValue))
+        let extraBytesSize = Int(DDGSYNCCRYPTO_ENCRYPTED_EXTRA_BYTES_SIZE.rawValue)
+
+        return performInChunks(count: values.count) { range in
+            var key = decryptionKey
+            // Holds encrypted bytes followed by raw bytes, reused for every value in the chunk.
+            var arena = [UInt8]()
+
+            return range.map { index in
+                Result<String, Error> {
+                    let value = values[index]
+                    guard !value.isEmpty else { return "" }
+                    guard let data = Data(base64Encoded: value) else {
+                        throw SyncError.failedToDecryptValue("Unable to decode base64 value")
+                    }
+                    guard data.count >= extraBytesSize else {
+                        throw SyncError.failedToDecryptValue("ddgSyncDecrypt failed: invalid ciphertext length: \(data.count)")
+                    }
+                    let encryptedCount = data.count
+                    let rawCount = encryptedCount - extraBytesSize
+                    let requiredCount = max(encryptedCount + rawCount, 1)
+                    if arena.count < requiredCount {
+                        arena = [UInt8](repeating: 0, count: max(requiredCount, 2 * arena.count))
+                    }
+
+                    return try arena.withUnsafeMutableBufferPointer { buffer in
+                        let encryptedBytes = buffer.baseAddress!
+                        let rawBytes = encryptedBytes + encryptedCount
+                        data.copyBytes(to: encryptedBytes, count: encryptedCount)
+
+                        let result = ddgSyncDecrypt(rawBytes, encryptedBytes, UInt64(encryptedCount), &key)
+                        guard DDGSYNCCRYPTO_OK == result else {
+                            throw SyncError.failedToDecryptValue("ddgSyncDecrypt failed: \(result)")
+                        }
+
+                        guard let decryptedValue = String(bytes: UnsafeBufferPointer(start: rawBytes, count: rawCount), encoding: .utf8) else {
+                            throw SyncError.failedToDecryptValue("bytes could not be converted to string")
+                        }
+                        return decryptedValue
+                    }
+                }
+            }
+        }
+    }
+
+    /// Splits `0..<count` into chunks processed concurrently and joins their per-value results in order.
+    private func performInChunks(count: Int, _ body: (Range<Int>) -> [Result<String, Error>]) -> [Result<String, Error>] {
+        let chunkSize = Self.batchChunkSize
+        let chunkCount = (count + chunkSize - 1) / chunkSize
+        guard chunkCount > 1 else {
+            return body(0..<count)
+        }
+
+        var chunkResults = [[Result<String, Error>]](repeating: [], count: chunkCount)
+        chunkResults.withUnsafeMutableBufferPointer { results in
+            DispatchQueue.concurrentPerform(iterations: chunkCount) { chunk in
+                let range = chunk * chunkSize ..< min(count, (chunk + 1) * chunkSize)
+                results[chunk] = body(range)
+            }
+        }
+        return Array(chunkResults.joined())
+    }
+
     func createAccountCreationKeys(userId: String, password: String) throws -> AccountCreationKeys {
 
         var primaryKey = [UInt8](repeating: 0, count: Int(DDGSYNCCRYPTO_PRIMARY_KEY_SIZE.rawValue))
@@ -55,6 +55,24 @@ extension RemoteAPIRequestCreating {
         )
     }
 
+    func createAuthenticatedJSONRequest(url: URL,
+                                        method: APIRequest.HTTPMethod,
+                                        authToken: String,
+                                        jsonFileURL: URL,
+                                        headers: [String: String] = [:],
+                                        parameters: [String: String] = [:]) -> HTTPRequesting {
+        var headers = headers
+        headers["Authorization"] = "Bearer \(authToken)"
+        return createRequest(
+            url: url,
+            method: method,
+            headers: headers,
+            parameters: parameters,
+            bodyFileURL: jsonFileURL,
+            contentType: "application/json"
+        )
+    }
+
     func createUnauthenticatedJSONRequest(url: URL,
                                           method: APIRequest.HTTPMethod,
                                           json: Data,
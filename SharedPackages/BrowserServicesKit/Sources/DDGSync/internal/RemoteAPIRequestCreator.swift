@@ -22,6 +22,12 @@ import Common
 import os.log
 public struct RemoteAPIRequestCreator: RemoteAPIRequestCreating {
 
+    let urlSession: URLSession
+
+    public init(urlSession: URLSession = .shared) {
+        self.urlSession = urlSession
+    }
+
     public func createRequest(url: URL,
                               method: APIRequest.HTTPMethod,
                               headers: HTTPHeaders,
@@ -45,7 +51,31 @@ public struct RemoteAPIRequestCreator: RemoteAPIRequestCreating {
             Logger.sync.debug("\(method.rawValue, privacy: .public) request body: \(String(bytes: body, encoding: .utf8) ?? "", privacy: .public)")
         }
 
-        return APIRequest(configuration: configuration, requirements: [.allowHTTPNotModified])
+        return APIRequest(configuration: configuration, requirements: [.allowHTTPNotModified], urlSession: urlSession)
+    }
+
+    public func createRequest(url: URL,
+                              method: APIRequest.HTTPMethod,
+                              headers: HTTPHeaders,
+                              parameters: [String: String],
+                              bodyFileURL: URL,
+                              contentType: String?) -> HTTPRequesting {
+
+        var requestHeaders = headers
+        if let contentType {
+            requestHeaders["Content-Type"] = contentType
+        }
+
+        let headers = APIRequest.Headers(additionalHeaders: requestHeaders)
+        let configuration = APIRequest.Configuration(url: url,
+                                                     method: method,
+                                                     queryParameters: parameters,
+                                                     headers: headers,
+                                                     bodyFileURL: bodyFileURL)
+
+        Logger.sync.debug("\(method.rawValue, privacy: .public) request with body uploaded from \(bodyFileURL.lastPathComponent, privacy: .public)")
+
+        return APIRequest(configuration: configuration, requirements: [.allowHTTPNotModified], urlSession: urlSession)
     }
 }
 
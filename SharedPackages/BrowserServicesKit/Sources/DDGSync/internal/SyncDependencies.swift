@@ -101,6 +101,13 @@ public protocol RemoteAPIRequestCreating {
                        parameters: [String: String],
                        body: Data?,
                        contentType: String?) -> HTTPRequesting
+
+    func createRequest(url: URL,
+                       method: APIRequest.HTTPMethod,
+                       headers: [String: String],
+                       parameters: [String: String],
+                       bodyFileURL: URL,
+                       contentType: String?) -> HTTPRequesting
 }
 
 protocol RecoveryKeyTransmitting {
@@ -18,15 +18,168 @@
 
 import Foundation
 import Gzip
+import os.log
+import zlib
+
+/// Produces a payload by passing consecutive chunks of it to the provided closure.
+typealias SyncPayloadWriter = (_ write: (Data) throws -> Void) throws -> Void
 
 protocol SyncPayloadCompressing {
     func compress(_ payload: Data) throws -> Data
+
+    /**
+     * Compresses the payload into a new temporary file and returns its URL.
+     *
+     * The caller owns the file and is responsible for removing it.
+     */
+    func compressedFile(of payload: SyncPayloadWriter) throws -> URL
+}
+
+extension SyncPayloadCompressing {
+
+    func compressedFile(of payload: SyncPayloadWriter) throws -> URL {
+        var data = Data()
+        try payload { data.append($0) }
+        let fileURL = SyncGzipPayloadCompressor.makeTemporaryFileURL()
+        try compress(data).write(to: fileURL)
+        return fileURL
+    }
 }
 
 struct SyncGzipPayloadCompressor: SyncPayloadCompressing {
+
     func compress(_ payload: Data) throws -> Data {
         try payload.gzipped()
     }
+
+    /**
+     * Compresses the payload into a temporary file as it's being generated.
+     *
+     * Only one chunk of the payload and of the compressed output is kept in memory at a time, so memory use doesn't
+     * depend on the payload size. Uploading from a file also lets URLSession re-read the body on redirects and retries.
+     * Any failure, including failing to write the file, throws before a request is created, so the caller can fall back
+     * to an uncompressed body.
+     */
+    func compressedFile(of payload: SyncPayloadWriter) throws -> URL {
+        let deflater = try SyncGzipDeflater()
+        let fileURL = Self.makeTemporaryFileURL()
+
+        guard FileManager.default.createFile(atPath: fileURL.path, contents: nil) else {
+            throw SyncGzipStreamError(errorCode: Int(Z_ERRNO))
+        }
+        do {
+            let fileHandle: FileHandle
+            do {
+                fileHandle = try FileHandle(forWritingTo: fileURL)
+            } catch {
+                throw SyncGzipStreamError(errorCode: Int(Z_ERRNO))
+            }
+            defer { try? fileHandle.close() }
+
+            try payload { chunk in
+                try deflater.deflate(chunk) { try fileHandle.writeCompressed($0) }
+            }
+            try deflater.finish { try fileHandle.writeCompressed($0) }
+            return fileURL
+        } catch {
+            try? FileManager.default.removeItem(at: fileURL)
+            Logger.sync.error("Failed to compress payload: \(error.localizedDescription, privacy: .public)")
+            throw error
+        }
+    }
+
+    static func makeTemporaryFileURL() -> URL {
+        FileManager.default.temporaryDirectory.appendingPathComponent("sync-payload-\(UUID().uuidString).json.gz")
+    }
+}
+
+struct SyncGzipStreamError: Error {
+    let errorCode: Int
+}
+
+/**
+ * Incremental gzip compression, writing output in chunks of bounded size.
+ */
+final class SyncGzipDeflater {
+
+    static let outputChunkSize = 32 * 1024
+
+    // zlib keeps a pointer to the stream, so it needs a stable address.
+    private let stream: UnsafeMutablePointer<z_stream>
+    private var outputBuffer = [UInt8](repeating: 0, count: SyncGzipDeflater.outputChunkSize)
+
+    init() throws {
+        stream = .allocate(capacity: 1)
+        stream.initialize(to: z_stream())
+
+        // 16 added to window bits selects gzip header and trailer.
+        let status = deflateInit2_(stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY,
+                                   ZLIB_VERSION, Int32(MemoryLayout<z_stream>.size))
+        guard status == Z_OK else {
+            stream.deinitialize(count: 1)
+            stream.deallocate()
+            throw SyncGzipStreamError(errorCode: Int(status))
+        }
+    }
+
+    deinit {
+        deflateEnd(stream)
+        stream.deinitialize(count: 1)
+        stream.deallocate()
+    }
+
+    func deflate(_ data: Data, output: (UnsafeRawBufferPointer) throws -> Void) throws {
+        guard !data.isEmpty else { return }
+        try run(data, flush: Z_NO_FLUSH, output: output)
+    }
+
+    func finish(output: (UnsafeRawBufferPointer) throws -> Void) throws {
+        try run(Data(), flush: Z_FINISH, output: output)
+    }
+
+    private func run(_ data: Data, flush: Int32, output: (UnsafeRawBufferPointer) throws -> Void) throws {
+        try data.withUnsafeBytes { input in
+            stream.pointee.next_in = UnsafeMutablePointer(mutating: input.bindMemory(to: Bytef.self).baseAddress)
+            stream.pointee.avail_in = uInt(input.count)
+            defer {
+                stream.pointee.next_in = nil
+                stream.pointee.avail_in = 0
+            }
+
+            while true {
+                let (status, produced) = outputBuffer.withUnsafeMutableBytes { buffer -> (Int32, Int) in
+                    stream.pointee.next_out = buffer.bindMemory(to: Bytef.self).baseAddress
+                    stream.pointee.avail_out = uInt(buffer.count)
+                    let status = zlib.deflate(stream, flush)
+                    return (status, buffer.count - Int(stream.pointee.avail_out))
+                }
+                guard status == Z_OK || status == Z_BUF_ERROR || status == Z_STREAM_END else {
+                    throw SyncGzipStreamError(errorCode: Int(status))
+                }
+                if produced > 0 {
+                    try outputBuffer.withUnsafeBytes { try output(UnsafeRawBufferPointer(rebasing: $0[0..<produced])) }
+                }
+
+                let isDone = flush == Z_FINISH ? status == Z_STREAM_END : stream.pointee.avail_in == 0 && produced < outputBuffer.count
+                if isDone {
+                    return
+                }
+            }
+        }
+    }
+}
+
+private extension FileHandle {
+
+    func writeCompressed(_ buffer: UnsafeRawBufferPointer) throws {
+        guard let baseAddress = buffer.baseAddress, buffer.count > 0 else { return }
+        do {
+            try write(contentsOf: Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: baseAddress), count: buffer.count, deallocator: .none))
+        } catch {
+            // Reported like a zlib file error, so that the request falls back to an uncompressed body.
+            throw SyncGzipStreamError(errorCode: Int(Z_ERRNO))
+        }
+    }
 }
 
 extension GzipError {
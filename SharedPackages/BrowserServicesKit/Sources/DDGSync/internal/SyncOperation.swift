@@ -216,6 +216,9 @@ final class SyncOperation: Operation, @unchecked Sendable {
             } catch let error as GzipError {
                 dataProvider.handleSyncError(SyncError.patchPayloadCompressionFailed(error.errorCode))
                 return try requestMaker.makePatchRequest(with: syncRequest, clientTimestamp: timestamp, isCompressed: false)
+            } catch let error as SyncGzipStreamError {
+                dataProvider.handleSyncError(SyncError.patchPayloadCompressionFailed(error.errorCode))
+                return try requestMaker.makePatchRequest(with: syncRequest, clientTimestamp: timestamp, isCompressed: false)
             }
         }
         return try requestMaker.makeGetRequest(with: syncRequest)
@@ -0,0 +1,80 @@
+//
+//  SyncPatchPayloadEncoder.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ * Encodes Sync PATCH request body incrementally, one syncable at a time.
+ *
+ * Produces the same JSON object as serializing the whole request at once:
+ * `{"<feature>":{"modified_since":"...","updates":[...]},"client_timestamp":"..."}`
+ */
+struct SyncPatchPayloadEncoder {
+
+    let featureName: String
+    let modifiedSince: String
+    let clientTimestamp: String
+    let updates: [[String: Any]]
+
+    init(request: SyncRequest, clientTimestamp: String) throws {
+        let updates = request.sent.map(\.payload)
+        // Validate upfront, so that encoding can't fail once the body is being sent.
+        guard updates.allSatisfy({ JSONSerialization.isValidJSONObject($0) }) else {
+            throw SyncError.unableToEncodeRequestBody("Sync PATCH payload is not a valid JSON")
+        }
+
+        self.featureName = request.feature.name
+        self.modifiedSince = request.previousSyncTimestamp ?? "0"
+        self.clientTimestamp = clientTimestamp
+        self.updates = updates
+    }
+
+    /// Passes consecutive chunks of the encoded body to `write`.
+    func encode(_ write: (Data) throws -> Void) throws {
+        var header = Data("{".utf8)
+        header.append(try Self.encodeString(featureName))
+        header.append(contentsOf: ":{\"modified_since\":".utf8)
+        header.append(try Self.encodeString(modifiedSince))
+        header.append(contentsOf: ",\"updates\":[".utf8)
+        try write(header)
+
+        for (index, update) in updates.enumerated() {
+            var record = index == 0 ? Data() : Data(",".utf8)
+            record.append(try JSONSerialization.data(withJSONObject: update, options: []))
+            try write(record)
+        }
+
+        var footer = Data("]},\"client_timestamp\":".utf8)
+        footer.append(try Self.encodeString(clientTimestamp))
+        footer.append(contentsOf: "}".utf8)
+        try write(footer)
+    }
+
+    /// Encodes the whole body into a single buffer.
+    func encode() throws -> Data {
+        var body = Data()
+        try encode { body.append($0) }
+        return body
+    }
+
+    private static func encodeString(_ string: String) throws -> Data {
+        // Top level fragments require newer OS versions, so encode the string as an array and drop the brackets.
+        let array = try JSONSerialization.data(withJSONObject: [string], options: [])
+        return array.dropFirst().dropLast()
+    }
+}
@@ -44,36 +44,26 @@ struct SyncRequestMaker: SyncRequestMaking {
     }
 
     func makePatchRequest(with result: SyncRequest, clientTimestamp: Date, isCompressed: Bool) throws -> HTTPRequesting {
-        var json = [String: Any]()
-        let modelPayload: [String: Any?] = [
-            "updates": result.sent.map(\.payload),
-            "modified_since": result.previousSyncTimestamp ?? "0"
-        ]
-        json[result.feature.name] = modelPayload
-        json["client_timestamp"] = dateFormatter.string(from: clientTimestamp)
-
-        guard JSONSerialization.isValidJSONObject(json) else {
-            throw SyncError.unableToEncodeRequestBody("Sync PATCH payload is not a valid JSON")
-        }
-
-        let body = try JSONSerialization.data(withJSONObject: json, options: [])
+        let encoder = try SyncPatchPayloadEncoder(request: result, clientTimestamp: dateFormatter.string(from: clientTimestamp))
 
         guard isCompressed else {
             return api.createAuthenticatedJSONRequest(
                 url: endpoints.syncPatch,
                 method: .patch,
                 authToken: try getToken(),
-                json: body
+                json: try encoder.encode()
             )
         }
 
-        let compressedBody = try payloadCompressor.compress(body)
-        return api.createAuthenticatedJSONRequest(
+        let authToken = try getToken()
+        let compressedBodyFile = try payloadCompressor.compressedFile(of: encoder.encode(_:))
+        let request = api.createAuthenticatedJSONRequest(
             url: endpoints.syncPatch,
             method: .patch,
-            authToken: try getToken(),
-            json: compressedBody,
+            authToken: authToken,
+            jsonFileURL: compressedBodyFile,
             headers: ["Content-Encoding": "gzip"])
+        return TemporaryBodyFileRequest(request: request, bodyFileURL: compressedBodyFile)
     }
 
     private func getToken() throws -> String {
@@ -88,3 +78,25 @@ struct SyncRequestMaker: SyncRequestMaking {
         return token
     }
 }
+
+/**
+ * Request whose body is uploaded from a temporary file, which is removed together with the request.
+ */
+final class TemporaryBodyFileRequest: HTTPRequesting {
+
+    let request: HTTPRequesting
+    let bodyFileURL: URL
+
+    init(request: HTTPRequesting, bodyFileURL: URL) {
+        self.request = request
+        self.bodyFileURL = bodyFileURL
+    }
+
+    deinit {
+        try? FileManager.default.removeItem(at: bodyFileURL)
+    }
+
+    func execute() async throws -> HTTPResult {
+        try await request.execute()
+    }
+}
@@ -23,6 +23,16 @@ import os.log
 
 public typealias BrowsingHistory = [HistoryEntry]
 
+/// Describes a change to the history, so observers don't need to diff the whole history dictionary.
+public enum HistoryChange {
+    /// History was replaced, e.g. after loading, cleaning or burning everything.
+    case reloaded
+    /// Entry was added or its visits, title or load state changed.
+    case updated(HistoryEntry)
+    /// Entries were removed.
+    case removed([HistoryEntry])
+}
+
 /**
  * This protocol allows for debugging History.
  */
@@ -42,7 +52,7 @@ public protocol HistoryCoordinating: AnyObject, HistoryCoordinatingDebuggingSupp
     var history: BrowsingHistory? { get }
     var allHistoryVisits: [Visit]? { get }
     var historyDictionary: [URL: HistoryEntry]? { get }
-    var historyDictionaryPublisher: Published<[URL: HistoryEntry]?>.Publisher { get }
+    var historyChangesPublisher: AnyPublisher<HistoryChange, Never> { get }
 
     @discardableResult func addVisit(of url: URL) -> Visit?
     func addBlockedTracker(entityName: String, on url: URL)
@@ -72,12 +82,15 @@ final public class HistoryCoordinator: HistoryCoordinating {
 
     let historyStoringProvider: () -> HistoryStoring
 
-    public init(historyStoring: @autoclosure @escaping () -> HistoryStoring) {
+    /// - Parameter tld: When provided, the eTLD+1 index used by `burnDomains` is maintained from the start.
+    ///   Otherwise it is built on the first burn, and rebuilt whenever `burnDomains` is given a different `TLD`.
+    public init(historyStoring: @autoclosure @escaping () -> HistoryStoring, tld: TLD? = nil) {
         self.historyStoringProvider = historyStoring
+        self.domainIndex = tld.map { HistoryDomainIndex(tld: $0, entries: []) }
     }
 
     public func loadHistory(onCleanFinished: @escaping () -> Void) {
-        historyDictionary = [:]
+        replaceHistoryDictionary(with: [:])
         cleanOldAndLoad(onCleanFinished: onCleanFinished)
         scheduleRegularCleaning()
     }
@@ -87,9 +100,13 @@ final public class HistoryCoordinator: HistoryCoordinating {
     }()
     private var regularCleaningTimer: Timer?
 
-    // Source of truth
-    @Published private(set) public var historyDictionary: [URL: HistoryEntry]?
-    public var historyDictionaryPublisher: Published<[URL: HistoryEntry]?>.Publisher { $historyDictionary }
+    // Source of truth, changes are published through `historyChangesPublisher`
+    private(set) public var historyDictionary: [URL: HistoryEntry]?
+
+    private let historyChangesSubject = PassthroughSubject<HistoryChange, Never>()
+    public var historyChangesPublisher: AnyPublisher<HistoryChange, Never> { historyChangesSubject.eraseToAnyPublisher() }
+
+    private var domainIndex: HistoryDomainIndex?
 
     // Output
     public var history: BrowsingHistory? {
@@ -112,11 +129,16 @@ final public class HistoryCoordinator: HistoryCoordinating {
             return nil
         }
 
+        let isNewEntry = historyDictionary[url] == nil
         let entry = historyDictionary[url] ?? HistoryEntry(url: url)
         let visit = entry.addVisit(at: date)
         entry.failedToLoad = false
 
         self.historyDictionary?[url] = entry
+        if isNewEntry {
+            domainIndex?.insert(entry)
+        }
+        historyChangesSubject.send(.updated(entry))
 
         commitChanges(url: url)
         return visit
@@ -159,6 +181,7 @@ final public class HistoryCoordinator: HistoryCoordinating {
         guard !title.isEmpty, entry.title != title else { return }
 
         entry.title = title
+        historyChangesSubject.send(.updated(entry))
     }
 
     public func markFailedToLoadUrl(_ url: URL) {
@@ -185,7 +208,7 @@ final public class HistoryCoordinator: HistoryCoordinating {
 
     public func burnAll(completion: @escaping () -> Void) {
         clean(until: Date()) {
-            self.historyDictionary = [:]
+            self.replaceHistoryDictionary(with: [:])
             completion()
         }
     }
@@ -193,14 +216,11 @@ final public class HistoryCoordinator: HistoryCoordinating {
     public func burnDomains(_ baseDomains: Set<String>, tld: TLD, completion: @escaping (Set<URL>) -> Void) {
         guard let historyDictionary = historyDictionary else { return }
 
-        var urls = Set<URL>()
-        let entries: [HistoryEntry] = historyDictionary.values.filter { historyEntry in
-            guard let host = historyEntry.url.host,
-                  let baseDomain = tld.eTLDplus1(host),
-                  baseDomains.contains(baseDomain) else { return false }
-            urls.insert(historyEntry.url)
-            return true
+        if domainIndex?.tld !== tld {
+            domainIndex = HistoryDomainIndex(tld: tld, entries: historyDictionary.values)
         }
+        let entries = domainIndex?.entries(forBaseDomains: baseDomains) ?? []
+        let urls = Set(entries.map(\.url))
 
         removeEntries(entries, completionHandler: { _ in
             completion(urls)
@@ -250,7 +270,8 @@ final public class HistoryCoordinator: HistoryCoordinating {
                 }
                 onCleanFinished?()
             }, receiveValue: { [weak self] history in
-                self?.historyDictionary = self?.makeHistoryDictionary(from: history)
+                guard let self else { return }
+                self.replaceHistoryDictionary(with: self.makeHistoryDictionary(from: history))
             })
             .store(in: &cancellables)
     }
@@ -259,7 +280,12 @@ final public class HistoryCoordinator: HistoryCoordinating {
                                completionHandler: ((Error?) -> Void)? = nil) {
         // Remove from the local memory
         entries.forEach { entry in
-            historyDictionary?.removeValue(forKey: entry.url)
+            if let removedEntry = historyDictionary?.removeValue(forKey: entry.url) {
+                domainIndex?.remove(removedEntry)
+            }
+        }
+        if !entries.isEmpty {
+            historyChangesSubject.send(.removed(entries))
         }
 
         // Remove from the storage
@@ -292,6 +318,7 @@ final public class HistoryCoordinator: HistoryCoordinating {
                     if let newLastVisit = historyEntry.visits.map({ $0.date }).max() {
                         historyEntry.lastVisit = newLastVisit
                         save(entry: historyEntry)
+                        historyChangesSubject.send(.updated(historyEntry))
                     } else {
                         assertionFailure("No history entry")
                     }
@@ -332,6 +359,14 @@ final public class HistoryCoordinator: HistoryCoordinating {
         regularCleaningTimer = timer
     }
 
+    private func replaceHistoryDictionary(with dictionary: [URL: HistoryEntry]) {
+        historyDictionary = dictionary
+        if let tld = domainIndex?.tld {
+            domainIndex = HistoryDomainIndex(tld: tld, entries: dictionary.values)
+        }
+        historyChangesSubject.send(.reloaded)
+    }
+
     private func makeHistoryDictionary(from history: BrowsingHistory) -> [URL: HistoryEntry] {
         dispatchPrecondition(condition: .onQueue(.main))
 
@@ -380,6 +415,7 @@ final public class HistoryCoordinator: HistoryCoordinating {
         }
 
         entry[keyPath: keyPath] = value
+        historyChangesSubject.send(.updated(entry))
     }
 
 }
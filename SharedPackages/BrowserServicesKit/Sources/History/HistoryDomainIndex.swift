@@ -0,0 +1,85 @@
+//
+//  HistoryDomainIndex.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import Common
+
+/// Secondary index of history entries by the eTLD+1 of their URL.
+///
+/// eTLD+1 is computed once per distinct host when an entry is added, so burning a set of domains
+/// only touches the entries belonging to them. The index holds references to the entries owned by
+/// `HistoryCoordinator.historyDictionary` rather than copies of their URLs.
+/// Hosts are forgotten once their last entry is removed.
+struct HistoryDomainIndex {
+
+    private struct HostInfo {
+        let baseDomain: String
+        var entryCount: Int
+    }
+
+    let tld: TLD
+
+    private(set) var entriesByBaseDomain = [String: Set<HistoryEntry>]()
+    private var hosts = [String: HostInfo]()
+
+    init(tld: TLD, entries: some Sequence<HistoryEntry>) {
+        self.tld = tld
+        for entry in entries {
+            insert(entry)
+        }
+    }
+
+    var hostCount: Int {
+        hosts.count
+    }
+
+    mutating func insert(_ entry: HistoryEntry) {
+        guard let host = entry.url.host else { return }
+
+        let baseDomain: String
+        if let info = hosts[host] {
+            baseDomain = info.baseDomain
+        } else if let eTLDplus1 = tld.eTLDplus1(host) {
+            baseDomain = eTLDplus1
+        } else {
+            return
+        }
+
+        guard entriesByBaseDomain[baseDomain, default: []].insert(entry).inserted else { return }
+        hosts[host, default: HostInfo(baseDomain: baseDomain, entryCount: 0)].entryCount += 1
+    }
+
+    mutating func remove(_ entry: HistoryEntry) {
+        guard let host = entry.url.host, let info = hosts[host] else { return }
+        guard entriesByBaseDomain[info.baseDomain]?.remove(entry) != nil else { return }
+
+        if entriesByBaseDomain[info.baseDomain]?.isEmpty == true {
+            entriesByBaseDomain[info.baseDomain] = nil
+        }
+        if info.entryCount > 1 {
+            hosts[host]?.entryCount -= 1
+        } else {
+            hosts[host] = nil
+        }
+    }
+
+    func entries(forBaseDomains baseDomains: Set<String>) -> [HistoryEntry] {
+        baseDomains.flatMap { entriesByBaseDomain[$0] ?? [] }
+    }
+
+}
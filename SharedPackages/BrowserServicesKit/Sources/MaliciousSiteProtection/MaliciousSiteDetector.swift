@@ -91,6 +91,9 @@ public final class MaliciousSiteDetector: MaliciousSiteDetecting {
 
     /// Evaluates the given URL to determine its malicious category (e.g., phishing, malware).
     public func evaluate(_ url: URL) async -> ThreatKind? {
+        let span = Tracer.beginSpan("MaliciousSiteDetector.evaluate")
+        defer { span.end() }
+
         guard let canonicalHost = url.canonicalHost(),
               let canonicalUrl = url.canonicalURL() else { return .none }
         let supportedThreats = supportedThreatsProvider()
@@ -143,7 +146,7 @@ public final class MaliciousSiteDetector: MaliciousSiteDetecting {
         let filterSet = await dataManager.dataSet(for: .filterSet(threatKind: threatKind))
         // Send Pixel clientSideHit parameter only if filterSet size is greater than 100
         // https://app.asana.com/0/0/1209113403594297/1209141231997704/f
-        let sanitisedClientSideHit = filterSet.filters.count > 100 ? clientSideHit : nil
+        let sanitisedClientSideHit = filterSet.count > 100 ? clientSideHit : nil
         eventMapping.fire(.errorPageShown(category: threatKind, clientSideHit: sanitisedClientSideHit))
     }
 }
@@ -16,13 +16,24 @@
 //  limitations under the License.
 //
 
+import BrowserServicesKit
 import Foundation
 
+/// When loaded from a protection data snapshot, filters are looked up in place in the mapped file
+/// until the dictionary is first mutated.
 struct FilterDictionary: Codable, Equatable {
 
+    enum CodingKeys: String, CodingKey {
+        case revision
+        case filters
+    }
+
     /// Filter set revision
     var revision: Int
 
+    private var snapshotFilters: ProtectionDataSnapshot.StringMultimap?
+    private var storedFilters: [String: Set<String>]
+
     /// [Hash: [RegEx]] mapping
     ///
     /// - **Key**: SHA256 hash sum of a canonical host name
@@ -36,14 +47,64 @@ struct FilterDictionary: Codable, Equatable {
     ///     ...
     /// }
     /// ```
-    var filters: [String: Set<String>]
+    var filters: [String: Set<String>] {
+        get {
+            snapshotFilters.map(Self.filters(from:)) ?? storedFilters
+        }
+        set {
+            snapshotFilters = nil
+            storedFilters = newValue
+        }
+    }
+
+    /// Number of host name hashes, same as `filters.count`
+    var count: Int {
+        snapshotFilters?.keyCount ?? storedFilters.count
+    }
+
+    /// Whether the filters are backed by a protection data snapshot
+    var isSnapshotBacked: Bool {
+        snapshotFilters != nil
+    }
+
+    init(revision: Int, filters: [String: Set<String>]) {
+        self.revision = revision
+        self.storedFilters = filters
+    }
+
+    init(snapshotFilters: ProtectionDataSnapshot.StringMultimap) {
+        self.revision = snapshotFilters.revision
+        self.snapshotFilters = snapshotFilters
+        self.storedFilters = [:]
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        self.revision = try container.decode(Int.self, forKey: .revision)
+        self.storedFilters = try container.decode([String: Set<String>].self, forKey: .filters)
+    }
+
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(revision, forKey: .revision)
+        try container.encode(filters, forKey: .filters)
+    }
+
+    static func == (lhs: FilterDictionary, rhs: FilterDictionary) -> Bool {
+        lhs.revision == rhs.revision && lhs.filters == rhs.filters
+    }
 
     /// Subscript to access regex patterns by SHA256 host name hash
     subscript(hash: String) -> Set<String>? {
-        filters[hash]
+        if let snapshotFilters {
+            let regexes = snapshotFilters.values(forKey: hash)
+            return regexes.isEmpty ? nil : Set(regexes)
+        }
+        return storedFilters[hash]
     }
 
     mutating func subtract<Seq: Sequence>(_ itemsToDelete: Seq) where Seq.Element == Filter {
+        materializeSnapshotFilters()
         for filter in itemsToDelete {
             // Remove the filter from the Set stored in the Dictionary by hash used as a key.
             // If the Set becomes empty – remove the Set value from the Dictionary.
@@ -51,16 +112,16 @@ struct FilterDictionary: Codable, Equatable {
             // The following code is equivalent to this one but without the Set value being copied
             // or key being searched multiple times:
             /*
-             if var filterSet = self.filters[filter.hash] {
+             if var filterSet = self.storedFilters[filter.hash] {
                 filterSet.remove(filter.regex)
                 if filterSet.isEmpty {
-                    self.filters[filter.hash] = nil
+                    self.storedFilters[filter.hash] = nil
                 } else {
-                    self.filters[filter.hash] = filterSet
+                    self.storedFilters[filter.hash] = filterSet
                 }
              }
             */
-            withUnsafeMutablePointer(to: &filters[filter.hash]) { item in
+            withUnsafeMutablePointer(to: &storedFilters[filter.hash]) { item in
                 item.pointee?.remove(filter.regex)
                 if item.pointee?.isEmpty == true {
                     item.pointee = nil
@@ -70,8 +131,21 @@ struct FilterDictionary: Codable, Equatable {
     }
 
     mutating func formUnion<Seq: Sequence>(_ itemsToAdd: Seq) where Seq.Element == Filter {
+        materializeSnapshotFilters()
         for filter in itemsToAdd {
-            filters[filter.hash, default: []].insert(filter.regex)
+            storedFilters[filter.hash, default: []].insert(filter.regex)
+        }
+    }
+
+    private mutating func materializeSnapshotFilters() {
+        guard let snapshotFilters else { return }
+        storedFilters = Self.filters(from: snapshotFilters)
+        self.snapshotFilters = nil
+    }
+
+    private static func filters(from snapshotFilters: ProtectionDataSnapshot.StringMultimap) -> [String: Set<String>] {
+        snapshotFilters.allPairs.reduce(into: [String: Set<String>]()) { result, pair in
+            result[pair.key, default: []].insert(pair.value)
         }
     }
 
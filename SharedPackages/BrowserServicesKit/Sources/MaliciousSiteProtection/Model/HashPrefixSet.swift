@@ -16,30 +16,92 @@
 //  limitations under the License.
 //
 
+import BrowserServicesKit
 import Foundation
 
 /// Structure storing a Set of hash prefixes ["6fe1e7c8","1d760415",...] and a revision of the set.
+///
+/// When loaded from a protection data snapshot, prefixes are queried in place in the mapped file
+/// until the set is first mutated.
 struct HashPrefixSet: Codable, Equatable {
 
+    enum CodingKeys: String, CodingKey {
+        case revision
+        case set
+    }
+
     var revision: Int
-    var set: Set<Element>
+    private var snapshotPrefixes: ProtectionDataSnapshot.HashPrefixes?
+    private var storedSet: Set<Element>
+
+    var set: Set<Element> {
+        get {
+            snapshotPrefixes.map { Set($0.allPrefixes) } ?? storedSet
+        }
+        set {
+            snapshotPrefixes = nil
+            storedSet = newValue
+        }
+    }
+
+    var count: Int {
+        snapshotPrefixes?.count ?? storedSet.count
+    }
+
+    /// Whether the prefixes are backed by a protection data snapshot
+    var isSnapshotBacked: Bool {
+        snapshotPrefixes != nil
+    }
 
     init(revision: Int, items: some Sequence<Element>) {
         self.revision = revision
-        self.set = Set(items)
+        self.storedSet = Set(items)
+    }
+
+    init(snapshotPrefixes: ProtectionDataSnapshot.HashPrefixes) {
+        self.revision = snapshotPrefixes.revision
+        self.snapshotPrefixes = snapshotPrefixes
+        self.storedSet = []
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        self.revision = try container.decode(Int.self, forKey: .revision)
+        self.storedSet = try container.decode(Set<Element>.self, forKey: .set)
+    }
+
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(revision, forKey: .revision)
+        try container.encode(set, forKey: .set)
+    }
+
+    static func == (lhs: HashPrefixSet, rhs: HashPrefixSet) -> Bool {
+        lhs.revision == rhs.revision && lhs.count == rhs.count && lhs.set == rhs.set
     }
 
     mutating func subtract<Seq: Sequence>(_ itemsToDelete: Seq) where Seq.Element == String {
-        set.subtract(itemsToDelete)
+        materializeSnapshotPrefixes()
+        storedSet.subtract(itemsToDelete)
     }
 
     mutating func formUnion<Seq: Sequence>(_ itemsToAdd: Seq) where Seq.Element == String {
-        set.formUnion(itemsToAdd)
+        materializeSnapshotPrefixes()
+        storedSet.formUnion(itemsToAdd)
+    }
+
+    private mutating func materializeSnapshotPrefixes() {
+        guard let snapshotPrefixes else { return }
+        storedSet = Set(snapshotPrefixes.allPrefixes)
+        self.snapshotPrefixes = nil
     }
 
     @inline(__always)
     func contains(_ item: String) -> Bool {
-        set.contains(item)
+        if let snapshotPrefixes {
+            return snapshotPrefixes.contains(item)
+        }
+        return storedSet.contains(item)
     }
 
 }
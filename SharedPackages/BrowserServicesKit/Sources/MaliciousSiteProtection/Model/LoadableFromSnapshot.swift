@@ -0,0 +1,54 @@
+//
+//  LoadableFromSnapshot.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import BrowserServicesKit
+import Foundation
+
+/// Data set that can be shared with other processes in a protection data snapshot
+protocol LoadableFromSnapshot {
+    var revision: Int { get }
+    /// Whether the data set is backed by a protection data snapshot
+    var isSnapshotBacked: Bool { get }
+
+    init?(snapshot: ProtectionDataSnapshot, threatKind: ThreatKind)
+
+    func add(to builder: inout ProtectionDataSnapshotBuilder, threatKind: ThreatKind) throws
+}
+
+extension HashPrefixSet: LoadableFromSnapshot {
+    init?(snapshot: ProtectionDataSnapshot, threatKind: ThreatKind) {
+        guard let prefixes = snapshot.maliciousSiteHashPrefixes(threatKind: threatKind.rawValue) else { return nil }
+        self.init(snapshotPrefixes: prefixes)
+    }
+
+    func add(to builder: inout ProtectionDataSnapshotBuilder, threatKind: ThreatKind) throws {
+        try builder.addMaliciousSiteHashPrefixes(set, revision: revision, threatKind: threatKind.rawValue)
+    }
+}
+
+extension FilterDictionary: LoadableFromSnapshot {
+    init?(snapshot: ProtectionDataSnapshot, threatKind: ThreatKind) {
+        guard let filters = snapshot.maliciousSiteFilters(threatKind: threatKind.rawValue) else { return nil }
+        self.init(snapshotFilters: filters)
+    }
+
+    func add(to builder: inout ProtectionDataSnapshotBuilder, threatKind: ThreatKind) throws {
+        let filters = filters.lazy.flatMap { hash, regexes in regexes.lazy.map { (hash: hash, regex: $0) } }
+        try builder.addMaliciousSiteFilters(filters, revision: revision, threatKind: threatKind.rawValue)
+    }
+}
@@ -20,7 +20,7 @@ import Foundation
 
 protocol MaliciousSiteDataKey: Hashable {
     associatedtype EmbeddedDataSet: Decodable
-    associatedtype DataSet: IncrementallyUpdatableDataSet, LoadableFromEmbeddedData<EmbeddedDataSet>
+    associatedtype DataSet: IncrementallyUpdatableDataSet, LoadableFromEmbeddedData<EmbeddedDataSet>, LoadableFromSnapshot
 
     var dataType: DataManager.StoredDataType { get }
     var threatKind: ThreatKind { get }
@@ -16,6 +16,7 @@
 //  limitations under the License.
 //
 
+import BrowserServicesKit
 import Foundation
 import os
 
@@ -34,27 +35,53 @@ public actor DataManager: DataManaging {
 
     private var store: [StoredDataType: Any] = [:]
 
-    public init(fileStore: FileStoring, embeddedDataProvider: EmbeddedDataProviding?, fileNameProvider: @escaping FileNameProvider) {
+    /// Protection data snapshot shared by the process that updates the data sets
+    private let snapshotStore: ProtectionDataSnapshotStore?
+    /// Whether stored data sets are published to `snapshotStore`: set in the process that updates the data sets
+    private let publishesSnapshot: Bool
+    private var snapshotGeneration: UInt64?
+
+    public init(fileStore: FileStoring,
+                embeddedDataProvider: EmbeddedDataProviding?,
+                fileNameProvider: @escaping FileNameProvider,
+                snapshotStore: ProtectionDataSnapshotStore? = nil,
+                publishesSnapshot: Bool = false) {
         self.embeddedDataProvider = embeddedDataProvider
         self.fileStore = fileStore
         self.fileNameProvider = fileNameProvider
+        self.snapshotStore = snapshotStore
+        self.publishesSnapshot = publishesSnapshot
     }
 
     func dataSet<DataKey: MaliciousSiteDataKey>(for key: DataKey) -> DataKey.DataSet {
         let dataType = key.dataType
+        let snapshot = snapshotStore?.snapshot
+        if let snapshot, snapshot.generation != snapshotGeneration {
+            // drop data sets backed by a replaced snapshot generation
+            store = store.filter { ($0.value as? LoadableFromSnapshot)?.isSnapshotBacked != true }
+            snapshotGeneration = snapshot.generation
+        }
+
         // return cached dataSet if available
         if let data = store[key.dataType] as? DataKey.DataSet {
             return data
         }
 
-        // read stored dataSet if it‘s newer than the embedded one
+        // use the newest of the shared snapshot, stored and embedded dataSets;
+        // on equal revisions the snapshot is preferred over the stored dataSet, which is preferred over the embedded one
         let dataSet: DataKey.DataSet
+        let embeddedRevision = embeddedDataProvider?.revision(for: dataType) ?? 0
+        let newestDataSet = [snapshot.flatMap { readSnapshotDataSet(for: key, from: $0) }, readStoredDataSet(for: key)]
+            .compactMap { $0 }
+            .max { $0.revision < $1.revision }
 
-        if let storedDataSet = readStoredDataSet(for: key) {
-            dataSet = storedDataSet
+        if let newestDataSet, newestDataSet.revision >= embeddedRevision {
+            dataSet = newestDataSet
         } else if let embeddedDataProvider {
-            // no stored dataSet or the embedded one is newer
-            let embeddedRevision = embeddedDataProvider.revision(for: dataType)
+            // no snapshot or stored dataSet or the embedded one is newer
+            if let newestDataSet {
+                Logger.dataManager.error("Shared and stored \(String(describing: dataType)) are outdated: revision: \(newestDataSet.revision), embedded revision: \(embeddedRevision).")
+            }
             let embeddedItems = embeddedDataProvider.loadDataSet(for: key)
             dataSet = .init(revision: embeddedRevision, items: embeddedItems)
         } else {
@@ -67,6 +94,10 @@ public actor DataManager: DataManaging {
         return dataSet
     }
 
+    private func readSnapshotDataSet<DataKey: MaliciousSiteDataKey>(for key: DataKey, from snapshot: ProtectionDataSnapshot) -> DataKey.DataSet? {
+        DataKey.DataSet(snapshot: snapshot, threatKind: key.threatKind)
+    }
+
     private func readStoredDataSet<DataKey: MaliciousSiteDataKey>(for key: DataKey) -> DataKey.DataSet? {
         let dataType = key.dataType
         let fileName = fileNameProvider(dataType)
@@ -80,13 +111,6 @@ public actor DataManager: DataManaging {
             return nil
         }
 
-        // compare to the embedded data revision
-        let embeddedDataRevision = embeddedDataProvider?.revision(for: dataType) ?? 0
-        guard storedDataSet.revision >= embeddedDataRevision else {
-            Logger.dataManager.error("Stored \(fileName) is outdated: revision: \(storedDataSet.revision), embedded revision: \(embeddedDataRevision).")
-            return nil
-        }
-
         return storedDataSet
     }
 
@@ -105,6 +129,53 @@ public actor DataManager: DataManaging {
         }
 
         try fileStore.write(data: data, to: fileName)
+
+        publishIfNeeded { try dataSet.add(to: &$0, threatKind: key.threatKind) }
+    }
+
+    /// Adds current data sets to a protection data snapshot, to share them with other processes.
+    /// Call after storing updated data sets, then publish the snapshot.
+    public func addDataSets(to builder: inout ProtectionDataSnapshotBuilder, threatKinds: [ThreatKind] = ThreatKind.allCases) throws {
+        for threatKind in threatKinds {
+            try dataSet(for: .hashPrefixes(threatKind: threatKind)).add(to: &builder, threatKind: threatKind)
+            try dataSet(for: .filterSet(threatKind: threatKind)).add(to: &builder, threatKind: threatKind)
+        }
+    }
+
+    /// Publishes the current data sets missing from the snapshot, e.g. on first launch or after the snapshot was removed.
+    /// Updated data sets are published when stored.
+    public func publishMissingDataSets(threatKinds: [ThreatKind] = ThreatKind.allCases) {
+        guard publishesSnapshot, let snapshotStore else { return }
+        let snapshot = snapshotStore.snapshot
+        var builder = ProtectionDataSnapshotBuilder()
+        do {
+            for threatKind in threatKinds {
+                try addDataSetIfMissing(for: .hashPrefixes(threatKind: threatKind), from: snapshot, to: &builder)
+                try addDataSetIfMissing(for: .filterSet(threatKind: threatKind), from: snapshot, to: &builder)
+            }
+        } catch {
+            Logger.dataManager.error("Error publishing protection data snapshot: \(String(describing: error), privacy: .public)")
+            return
+        }
+        guard !builder.isEmpty else { return }
+        publishIfNeeded { $0 = builder }
+    }
+
+    private func addDataSetIfMissing<DataKey: MaliciousSiteDataKey>(for key: DataKey, from snapshot: ProtectionDataSnapshot?, to builder: inout ProtectionDataSnapshotBuilder) throws {
+        guard snapshot.flatMap({ readSnapshotDataSet(for: key, from: $0) }) == nil else { return }
+        try dataSet(for: key).add(to: &builder, threatKind: key.threatKind)
+    }
+
+    /// Failing to publish is not an error of the update: other processes keep reading the stored data set until published.
+    private func publishIfNeeded(_ addDataSets: (inout ProtectionDataSnapshotBuilder) throws -> Void) {
+        guard publishesSnapshot, let snapshotStore else { return }
+        do {
+            var builder = ProtectionDataSnapshotBuilder()
+            try addDataSets(&builder)
+            try snapshotStore.publish(builder)
+        } catch {
+            Logger.dataManager.error("Error publishing protection data snapshot: \(String(describing: error), privacy: .public)")
+        }
     }
 
 }
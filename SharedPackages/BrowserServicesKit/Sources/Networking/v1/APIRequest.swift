@@ -24,6 +24,7 @@ public typealias APIRequestCompletion = (APIResponse?, APIRequest.Error?) -> Voi
 
 public struct APIRequest {
     let request: URLRequest
+    private let bodyFileURL: URL?
     private let requirements: APIResponseRequirements
     private let urlSession: URLSession
 
@@ -31,6 +32,7 @@ public struct APIRequest {
                                          requirements: APIResponseRequirements = [],
                                          urlSession: URLSession = .shared) {
         self.request = configuration.request
+        self.bodyFileURL = configuration.bodyFileURL
         self.requirements = requirements
         self.urlSession = urlSession
 
@@ -43,7 +45,7 @@ public struct APIRequest {
     @available(*, deprecated, message: "Please use 'APIService' instead.")
     @discardableResult public func fetch(completion: @escaping APIRequestCompletion) -> URLSessionDataTask {
         Logger.networking.debug("Requesting \(request.httpMethod ?? "") \(request.url?.absoluteString ?? ""), headers \(String(describing: request.allHTTPHeaderFields ?? [:]))")
-        let task = urlSession.dataTask(with: request) { (data, urlResponse, error) in
+        let completionHandler: (Data?, URLResponse?, Swift.Error?) -> Void = { (data, urlResponse, error) in
             if let error = error {
                 completion(nil, .urlSession(error))
             } else {
@@ -56,6 +58,12 @@ public struct APIRequest {
                 }
             }
         }
+        let task: URLSessionDataTask
+        if let bodyFileURL {
+            task = urlSession.uploadTask(with: request, fromFile: bodyFileURL, completionHandler: completionHandler)
+        } else {
+            task = urlSession.dataTask(with: request, completionHandler: completionHandler)
+        }
         task.resume()
         return task
     }
@@ -94,6 +102,9 @@ public struct APIRequest {
 
     fileprivate func fetch(for request: URLRequest) async throws -> (Data, URLResponse) {
         do {
+            if let bodyFileURL {
+                return try await urlSession.upload(for: request, fromFile: bodyFileURL)
+            }
             return try await urlSession.data(for: request)
         } catch let error {
             throw Error.urlSession(error)
@@ -28,6 +28,7 @@ extension APIRequest {
         let allowedQueryReservedCharacters: CharacterSet?
         let headers: HTTPHeaders
         let body: Data?
+        let bodyFileURL: URL?
         let timeoutInterval: TimeInterval
         let cachePolicy: URLRequest.CachePolicy?
 
@@ -37,6 +38,7 @@ extension APIRequest {
                     allowedQueryReservedCharacters: CharacterSet? = nil,
                     headers: APIRequest.Headers = APIRequest.Headers(),
                     body: Data? = nil,
+                    bodyFileURL: URL? = nil,
                     timeoutInterval: TimeInterval = 60.0,
                     cachePolicy: URLRequest.CachePolicy? = nil) {
             self.url = url
@@ -45,6 +47,7 @@ extension APIRequest {
             self.allowedQueryReservedCharacters = allowedQueryReservedCharacters
             self.headers = headers.httpHeaders
             self.body = body
+            self.bodyFileURL = bodyFileURL
             self.timeoutInterval = timeoutInterval
             self.cachePolicy = cachePolicy
         }
@@ -54,7 +57,10 @@ extension APIRequest {
             var request = URLRequest(url: url, timeoutInterval: timeoutInterval)
             request.allHTTPHeaderFields = headers
             request.httpMethod = method.rawValue
-            request.httpBody = body
+            // A body file is passed to the upload task instead, so that it can be re-read on redirects and retries.
+            if bodyFileURL == nil {
+                request.httpBody = body
+            }
             if let cachePolicy = cachePolicy {
                 request.cachePolicy = cachePolicy
             }
@@ -52,6 +52,9 @@ struct ScoringService {
     ///
     /// - Returns: An integer score representing how well the suggestion matches the query.
     static func score(title: String?, url: URL, visitCount: Int = 0, lowercasedQuery lowerQuery: String, queryTokens: [String]? = nil) -> Int { // swiftlint:disable:this cyclomatic_complexity
+        let span = Tracer.beginSpan("ScoringService.score")
+        defer { span.end() }
+
         // To optimize, query tokens can be precomputed
         let queryTokens = queryTokens ?? lowerQuery.tokenized()
         assert(lowerQuery.lowercased() == lowerQuery)
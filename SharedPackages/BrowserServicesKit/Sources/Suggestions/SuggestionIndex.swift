@@ -0,0 +1,332 @@
+//
+//  SuggestionIndex.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Common
+import Foundation
+
+/// Token-prefix index over history entries and bookmarks, used to narrow down candidates before scoring.
+///
+/// Every entry is indexed under the pre-lowercased words of its title, its naked URL and the suffixes of its domain,
+/// which covers every way `ScoringService.score` can produce a non-zero score. A query returns only the entries that
+/// have a key starting with each of the query tokens, so the result is a superset of the entries that would score.
+///
+/// The index is updated incrementally: only entries whose URL or title changed are re-tokenized. Bulk updates collect
+/// added and removed keys and rebuild the sorted key list once, so building the index from full history stays `O(n log n)`.
+public final class SuggestionIndex {
+
+    private enum Document {
+        case history(HistorySuggestion)
+        case bookmark(Bookmark)
+    }
+
+    private struct IndexedDocument {
+        var document: Document
+        let signature: String
+        let keys: [String]
+    }
+
+    // Domain suffixes are only matched for queries longer than 2 characters.
+    private static let minimumDomainSuffixLength = 3
+
+    private let lock = NSLock()
+
+    private var documents = [IndexedDocument?]()
+    private var freeSlots = [Int]()
+    private var historySlots = [UUID: Int]()
+    private var bookmarkSlots = [String: [Int]]()
+
+    private var postings = [String: Set<Int>]()
+    // Keys of `postings`, kept sorted for prefix range lookups.
+    private var sortedKeys = [String]()
+
+    // While a bulk update is in progress, `sortedKeys` is only brought in sync with `postings` once it completes.
+    private var isBatchUpdating = false
+    private var addedKeys = [String]()
+    private var hasRemovedKeys = false
+
+    public init() {}
+
+    public var count: Int {
+        lock.lock(); defer { lock.unlock() }
+        return documents.count - freeSlots.count
+    }
+
+    // MARK: - Updates
+
+    /// Synchronizes history part of the index with the given entries.
+    public func updateHistory(_ entries: [HistorySuggestion]) {
+        lock.lock(); defer { lock.unlock() }
+        beginBatchUpdate()
+        defer { endBatchUpdate() }
+
+        var remaining = historySlots
+        for entry in entries {
+            remaining.removeValue(forKey: entry.identifier)
+            upsertHistoryEntry(entry)
+        }
+        for (identifier, slot) in remaining {
+            removeDocument(at: slot)
+            historySlots[identifier] = nil
+        }
+    }
+
+    public func updateHistoryEntry(_ entry: HistorySuggestion) {
+        lock.lock(); defer { lock.unlock() }
+        upsertHistoryEntry(entry)
+    }
+
+    public func removeHistoryEntry(withIdentifier identifier: UUID) {
+        lock.lock(); defer { lock.unlock() }
+        guard let slot = historySlots.removeValue(forKey: identifier) else { return }
+        removeDocument(at: slot)
+    }
+
+    public func removeHistoryEntries(withIdentifiers identifiers: [UUID]) {
+        lock.lock(); defer { lock.unlock() }
+        beginBatchUpdate()
+        defer { endBatchUpdate() }
+
+        for identifier in identifiers {
+            guard let slot = historySlots.removeValue(forKey: identifier) else { continue }
+            removeDocument(at: slot)
+        }
+    }
+
+    /// Synchronizes bookmarks part of the index with the given bookmarks.
+    public func updateBookmarks(_ bookmarks: [Bookmark]) {
+        lock.lock(); defer { lock.unlock() }
+        beginBatchUpdate()
+        defer { endBatchUpdate() }
+
+        var unmatched = bookmarkSlots
+        var slots = [String: [Int]]()
+
+        for bookmark in bookmarks {
+            let signature = Self.signature(for: bookmark)
+            if var existing = unmatched[signature], let slot = existing.popLast() {
+                unmatched[signature] = existing
+                documents[slot]?.document = .bookmark(bookmark)
+                slots[signature, default: []].append(slot)
+            } else if let slot = insertDocument(.bookmark(bookmark), signature: signature) {
+                slots[signature, default: []].append(slot)
+            }
+        }
+
+        for slot in unmatched.values.joined() {
+            removeDocument(at: slot)
+        }
+        bookmarkSlots = slots
+    }
+
+    private func upsertHistoryEntry(_ entry: HistorySuggestion) {
+        let signature = Self.signature(for: entry)
+        if let slot = historySlots[entry.identifier] {
+            if documents[slot]?.signature == signature {
+                documents[slot]?.document = .history(entry)
+                return
+            }
+            removeDocument(at: slot)
+            historySlots[entry.identifier] = nil
+        }
+        if let slot = insertDocument(.history(entry), signature: signature) {
+            historySlots[entry.identifier] = slot
+        }
+    }
+
+    private func insertDocument(_ document: Document, signature: String) -> Int? {
+        let keys: [String]
+        switch document {
+        case .history(let entry):
+            keys = Self.keys(title: entry.title, url: entry.url)
+        case .bookmark(let bookmark):
+            guard let url = URL(string: bookmark.url) else { return nil }
+            keys = Self.keys(title: bookmark.title, url: url)
+        }
+
+        let slot: Int
+        if let freeSlot = freeSlots.popLast() {
+            slot = freeSlot
+            documents[slot] = IndexedDocument(document: document, signature: signature, keys: keys)
+        } else {
+            slot = documents.count
+            documents.append(IndexedDocument(document: document, signature: signature, keys: keys))
+        }
+
+        for key in keys {
+            if postings[key]?.insert(slot) == nil {
+                postings[key] = [slot]
+                if isBatchUpdating {
+                    addedKeys.append(key)
+                } else {
+                    sortedKeys.insert(key, at: lowerBound(of: key))
+                }
+            }
+        }
+        return slot
+    }
+
+    private func removeDocument(at slot: Int) {
+        guard let indexed = documents[slot] else { return }
+        for key in indexed.keys {
+            postings[key]?.remove(slot)
+            if postings[key]?.isEmpty == true {
+                postings[key] = nil
+                if isBatchUpdating {
+                    hasRemovedKeys = true
+                    continue
+                }
+                let position = lowerBound(of: key)
+                if position < sortedKeys.count, sortedKeys[position] == key {
+                    sortedKeys.remove(at: position)
+                }
+            }
+        }
+        documents[slot] = nil
+        freeSlots.append(slot)
+    }
+
+    private func beginBatchUpdate() {
+        isBatchUpdating = true
+    }
+
+    private func endBatchUpdate() {
+        isBatchUpdating = false
+
+        if hasRemovedKeys {
+            sortedKeys.removeAll { postings[$0] == nil }
+            hasRemovedKeys = false
+        }
+        guard !addedKeys.isEmpty else { return }
+
+        // A key removed and added again within the batch is still in `sortedKeys`, the merge skips such duplicates.
+        addedKeys.sort()
+        var merged = [String]()
+        merged.reserveCapacity(sortedKeys.count + addedKeys.count)
+        var existing = sortedKeys.makeIterator()
+        var added = addedKeys.makeIterator()
+        var nextExisting = existing.next()
+        var nextAdded = added.next()
+        while let key = Self.smaller(nextExisting, nextAdded) {
+            if merged.last != key, postings[key] != nil {
+                merged.append(key)
+            }
+            if nextExisting == key { nextExisting = existing.next() }
+            if nextAdded == key { nextAdded = added.next() }
+        }
+        sortedKeys = merged
+        addedKeys.removeAll()
+    }
+
+    private static func smaller(_ lhs: String?, _ rhs: String?) -> String? {
+        guard let lhs else { return rhs }
+        guard let rhs else { return lhs }
+        return min(lhs, rhs)
+    }
+
+    // MARK: - Queries
+
+    /// Returns history entries and bookmarks that have an indexed key starting with every token of the query.
+    public func candidates(for query: String) -> (history: [HistorySuggestion], bookmarks: [Bookmark]) {
+        let tokens = query.trimmingCharacters(in: .whitespacesAndNewlines).lowercased().tokenized()
+        guard !tokens.isEmpty else { return ([], []) }
+
+        lock.lock(); defer { lock.unlock() }
+
+        var matching: Set<Int>?
+        // Longer tokens have fewer matches, start with them to keep intermediate sets small.
+        for token in tokens.sorted(by: { $0.count > $1.count }) {
+            var tokenMatches = Set<Int>()
+            var position = lowerBound(of: token)
+            while position < sortedKeys.count, sortedKeys[position].hasPrefix(token) {
+                if let slots = postings[sortedKeys[position]] {
+                    if let matching {
+                        tokenMatches.formUnion(slots.lazy.filter { matching.contains($0) })
+                    } else {
+                        tokenMatches.formUnion(slots)
+                    }
+                }
+                position += 1
+            }
+            matching = tokenMatches
+            if tokenMatches.isEmpty { break }
+        }
+
+        var history = [HistorySuggestion]()
+        var bookmarks = [Bookmark]()
+        for slot in (matching ?? []).sorted() {
+            switch documents[slot]?.document {
+            case .history(let entry): history.append(entry)
+            case .bookmark(let bookmark): bookmarks.append(bookmark)
+            case .none: continue
+            }
+        }
+        return (history, bookmarks)
+    }
+
+    private func lowerBound(of key: String) -> Int {
+        var low = 0
+        var high = sortedKeys.count
+        while low < high {
+            let mid = (low + high) / 2
+            if sortedKeys[mid] < key {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low
+    }
+
+    // MARK: - Tokenization
+
+    private static func signature(for entry: HistorySuggestion) -> String {
+        entry.url.absoluteString + "\n" + (entry.title ?? "")
+    }
+
+    private static func signature(for bookmark: Bookmark) -> String {
+        bookmark.url + "\n" + bookmark.title + (bookmark.isFavorite ? "\n*" : "")
+    }
+
+    static func keys(title: String?, url: URL) -> [String] {
+        var keys = Set<String>()
+
+        let lowercasedTitle = title?.lowercased() ?? ""
+        for word in lowercasedTitle.tokenized() {
+            keys.insert(word)
+        }
+        // Title matching ignores leading punctuation, e.g. `"Cats` is matched by `cats`.
+        if let firstWord = lowercasedTitle.trimmingCharacters(in: .alphanumerics.inverted).tokenized().first {
+            keys.insert(firstWord)
+        }
+
+        if let nakedUrl = url.nakedString, !nakedUrl.isEmpty {
+            keys.insert(nakedUrl)
+        }
+
+        // Domain matches anywhere, index all of its suffixes long enough to be matched.
+        let domain = url.host?.droppingWwwPrefix() ?? ""
+        var suffix = domain[...]
+        while suffix.count >= minimumDomainSuffixLength {
+            keys.insert(String(suffix))
+            suffix = suffix.dropFirst()
+        }
+
+        return Array(keys)
+    }
+
+}
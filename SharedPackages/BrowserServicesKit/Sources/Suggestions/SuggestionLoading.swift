@@ -56,8 +56,10 @@ public class SuggestionLoader: SuggestionLoading {
         }
 
         // 1) Getting all necessary data
-        let bookmarks = dataSource.bookmarks(for: self)
-        let history = dataSource.history(for: self)
+        // When an index is available, only history entries and bookmarks matching every query token are scored
+        let indexCandidates = dataSource.suggestionIndex(for: self)?.candidates(for: query)
+        let bookmarks = indexCandidates?.bookmarks ?? dataSource.bookmarks(for: self)
+        let history = indexCandidates?.history ?? dataSource.history(for: self)
         let internalPages = dataSource.internalPages(for: self)
         let openTabs = dataSource.openTabs(for: self)
         var apiResult: APIResult?
@@ -117,6 +119,8 @@ public protocol SuggestionLoadingDataSource: AnyObject {
 
     func history(for suggestionLoading: SuggestionLoading) -> [HistorySuggestion]
 
+    func suggestionIndex(for suggestionLoading: SuggestionLoading) -> SuggestionIndex?
+
     func internalPages(for suggestionLoading: SuggestionLoading) -> [InternalPage]
 
     func openTabs(for suggestionLoading: SuggestionLoading) -> [BrowserTab]
@@ -127,3 +131,11 @@ public protocol SuggestionLoadingDataSource: AnyObject {
                            completion: @escaping (Data?, Error?) -> Void)
 
 }
+
+public extension SuggestionLoadingDataSource {
+
+    func suggestionIndex(for suggestionLoading: SuggestionLoading) -> SuggestionIndex? {
+        nil
+    }
+
+}
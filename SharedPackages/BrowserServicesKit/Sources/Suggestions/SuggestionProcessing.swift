@@ -72,8 +72,7 @@ struct SuggestionProcessing {
             internalPages.compactMap(ScoringService.scored(lowercasedQuery: lowerQuery, queryTokens: queryTokens, isUrlIgnored: isUrlIgnored)),
         ]
             .joined()
-            .sorted { $0.score > $1.score }
-            .prefix(100) // limit max len optimization
+            .topScored(100) // limit max len optimization
 
         // STEP 4: Deduplicate the results by grouping on URL and get the "best" suggestion for each. We also receive
         // a list of SuggestionKind values for each URL to support better categorization below.
@@ -302,3 +301,54 @@ private extension Suggestion {
         }
     }
 }
+
+extension Sequence where Element == ScoredSuggestion {
+
+    /// Returns up to `count` suggestions with the highest score, ordered by descending score.
+    /// Suggestions with equal scores keep their relative order, same as a stable sort followed by `prefix(count)`.
+    func topScored(_ count: Int) -> [ScoredSuggestion] {
+        guard count > 0 else { return [] }
+
+        // Min-heap with the worst kept suggestion at the root: lowest score, latest position for equal scores.
+        var heap = [(suggestion: ScoredSuggestion, offset: Int)]()
+        heap.reserveCapacity(count)
+
+        func isWorse(_ lhs: (suggestion: ScoredSuggestion, offset: Int), _ rhs: (suggestion: ScoredSuggestion, offset: Int)) -> Bool {
+            lhs.suggestion.score != rhs.suggestion.score ? lhs.suggestion.score < rhs.suggestion.score : lhs.offset > rhs.offset
+        }
+
+        func siftDown(from index: Int) {
+            var parent = index
+            while true {
+                let left = 2 * parent + 1
+                let right = left + 1
+                var candidate = parent
+                if left < heap.count && isWorse(heap[left], heap[candidate]) { candidate = left }
+                if right < heap.count && isWorse(heap[right], heap[candidate]) { candidate = right }
+                guard candidate != parent else { return }
+                heap.swapAt(parent, candidate)
+                parent = candidate
+            }
+        }
+
+        for (offset, suggestion) in enumerated() {
+            let element = (suggestion: suggestion, offset: offset)
+            if heap.count < count {
+                heap.append(element)
+                var child = heap.count - 1
+                while child > 0 {
+                    let parent = (child - 1) / 2
+                    guard isWorse(heap[child], heap[parent]) else { break }
+                    heap.swapAt(child, parent)
+                    child = parent
+                }
+            } else if isWorse(heap[0], element) {
+                heap[0] = element
+                siftDown(from: 0)
+            }
+        }
+
+        return heap.sorted { isWorse($1, $0) }.map(\.suggestion)
+    }
+
+}
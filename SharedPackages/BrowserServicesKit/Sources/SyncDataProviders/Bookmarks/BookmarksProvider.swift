@@ -98,9 +98,10 @@ public final class BookmarksProvider: DataProvider {
         let encryptionKey = try crypter.fetchSecretKey()
         context.performAndWait {
             let bookmarks = BookmarkUtils.fetchModifiedBookmarks(context)
+            let encrypter = BatchEncrypter(values: bookmarks.flatMap(Syncable.valuesToEncrypt(for:)), crypter: crypter, secretKey: encryptionKey)
             syncableBookmarks = bookmarks.compactMap { bookmarkEntity in
                 do {
-                    return try Syncable(bookmark: bookmarkEntity, encryptedUsing: { try crypter.encryptAndBase64Encode($0, using: encryptionKey)})
+                    return try Syncable(bookmark: bookmarkEntity, encryptedUsing: encrypter.encrypt)
                 } catch {
                     if case Syncable.SyncableBookmarkError.validationFailed = error {
                         Logger.bookmarks.error("Validation failed for bookmark \(bookmarkEntity.uuid ?? "") with title: \(bookmarkEntity.title.flatMap { String($0.prefix(100)) } ?? "")")
@@ -62,7 +62,10 @@ final class BookmarksResponseHandler {
         self.metricsEvents = metricsEvents
 
         let secretKey = try crypter.fetchSecretKey()
-        self.decrypt = { try crypter.base64DecodeAndDecrypt($0, using: secretKey) }
+        let decrypter = BatchDecrypter(values: self.received.flatMap { [$0.encryptedTitle, $0.encryptedUrl].compactMap { $0 } },
+                                       crypter: crypter,
+                                       secretKey: secretKey)
+        self.decrypt = { try decrypter.decrypt($0) }
 
         var syncablesByUUID: [String: SyncableBookmarkAdapter] = [:]
         var allUUIDs: Set<String> = []
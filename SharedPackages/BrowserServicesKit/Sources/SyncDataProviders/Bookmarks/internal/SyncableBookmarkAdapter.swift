@@ -80,6 +80,17 @@ extension Syncable {
         static let maxEncryptedBookmarkURLLength = 3000
     }
 
+    /// Values that `init(bookmark:encryptedUsing:)` encrypts for the bookmark, used to encrypt them upfront in a batch.
+    static func valuesToEncrypt(for bookmark: BookmarkEntity) -> [String] {
+        guard bookmark.uuid != nil, !bookmark.isPendingDeletion else {
+            return []
+        }
+        if bookmark.isFolder {
+            return bookmark.title.map { [String($0.prefix(BookmarkValidationConstraints.maxFolderTitleLength))] } ?? []
+        }
+        return [bookmark.title, bookmark.url].compactMap { $0 }
+    }
+
     // swiftlint:disable:next cyclomatic_complexity
     init(bookmark: BookmarkEntity, encryptedUsing encrypt: (String) throws -> String) throws {
         var payload: [String: Any] = [:]
@@ -0,0 +1,78 @@
+//
+//  BatchCrypting.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import DDGSync
+import Foundation
+
+/**
+ * Encrypts values known upfront in a single batch, and hands them out to syncable adapters one by one.
+ *
+ * Every occurrence of a value gets its own ciphertext. Values that were not part of the batch,
+ * or failed to encrypt in it, are encrypted individually.
+ */
+final class BatchEncrypter {
+
+    private let crypter: Crypting
+    private let secretKey: Data
+    private var encryptedValues: [String: [String]] = [:]
+
+    init(values: [String], crypter: Crypting, secretKey: Data) {
+        self.crypter = crypter
+        self.secretKey = secretKey
+
+        for (value, result) in zip(values, crypter.encryptAndBase64Encode(values, using: secretKey)) {
+            guard case .success(let encryptedValue) = result else { continue }
+            encryptedValues[value, default: []].append(encryptedValue)
+        }
+    }
+
+    func encrypt(_ value: String) throws -> String {
+        if let encryptedValue = encryptedValues[value]?.popLast() {
+            return encryptedValue
+        }
+        return try crypter.encryptAndBase64Encode(value, using: secretKey)
+    }
+}
+
+/**
+ * Decrypts values of received syncables in a single batch.
+ *
+ * Each value keeps its own result, so a value that failed to decrypt reports its error
+ * without affecting the others. Values that were not part of the batch are decrypted individually.
+ */
+struct BatchDecrypter {
+
+    private let crypter: Crypting
+    private let secretKey: Data
+    private let decryptedValues: [String: Result<String, Error>]
+
+    init(values: [String], crypter: Crypting, secretKey: Data) {
+        self.crypter = crypter
+        self.secretKey = secretKey
+
+        decryptedValues = Dictionary(zip(values, crypter.base64DecodeAndDecrypt(values, using: secretKey)),
+                                     uniquingKeysWith: { first, _ in first })
+    }
+
+    func decrypt(_ value: String) throws -> String {
+        if let decryptedValue = decryptedValues[value] {
+            return try decryptedValue.get()
+        }
+        return try crypter.base64DecodeAndDecrypt(value, using: secretKey)
+    }
+}
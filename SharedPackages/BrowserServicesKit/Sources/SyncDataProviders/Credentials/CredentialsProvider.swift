@@ -103,11 +103,14 @@ public final class CredentialsProvider: DataProvider {
         let secureVault = try secureVaultFactory.makeVault(reporter: secureVaultErrorReporter)
         let syncableCredentials = try secureVault.modifiedSyncableCredentials()
         let encryptionKey = try crypter.fetchSecretKey()
+        let encrypter = BatchEncrypter(values: syncableCredentials.flatMap(Syncable.valuesToEncrypt(for:)),
+                                       crypter: crypter,
+                                       secretKey: encryptionKey)
         return try syncableCredentials.compactMap { credentials in
             do {
                 return try Syncable(
                     syncableCredentials: credentials,
-                    encryptedUsing: { try crypter.encryptAndBase64Encode($0, using: encryptionKey) }
+                    encryptedUsing: encrypter.encrypt
                 )
             } catch Syncable.SyncableCredentialError.validationFailed {
                 Logger.sync.error("Validation failed for credential \(credentials.metadata.uuid) with title: \(credentials.account?.title.flatMap { String($0.prefix(100)) } ?? "")")
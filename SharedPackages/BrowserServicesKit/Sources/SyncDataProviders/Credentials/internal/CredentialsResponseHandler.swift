@@ -57,7 +57,11 @@ final class CredentialsResponseHandler {
         self.metricsEvents = metricsEvents
 
         let secretKey = try crypter.fetchSecretKey()
-        self.decrypt = { try crypter.base64DecodeAndDecrypt($0, using: secretKey) }
+        let encryptedValues = self.received.flatMap {
+            [$0.encryptedTitle, $0.encryptedDomain, $0.encryptedUsername, $0.encryptedPassword, $0.encryptedNotes].compactMap { $0 }
+        }
+        let decrypter = BatchDecrypter(values: encryptedValues, crypter: crypter, secretKey: secretKey)
+        self.decrypt = { try decrypter.decrypt($0) }
 
         var allUUIDs: Set<String> = []
 
@@ -71,6 +71,16 @@ extension Syncable {
         static let maxEncryptedNotesLength = 1000
     }
 
+    /// Values that `init(syncableCredentials:encryptedUsing:)` encrypts for the credentials, used to encrypt them upfront in a batch.
+    static func valuesToEncrypt(for syncableCredentials: SecureVaultModels.SyncableCredentials) -> [String] {
+        guard let credential = syncableCredentials.credentials else {
+            return []
+        }
+        let account = credential.account
+        let password = credential.password.flatMap { String(data: $0, encoding: .utf8) }
+        return [account.title, account.domain, account.username, account.notes, password].compactMap { $0 }
+    }
+
     // swiftlint:disable:next cyclomatic_complexity
     init(syncableCredentials: SecureVaultModels.SyncableCredentials, encryptedUsing encrypt: (String) throws -> String) throws {
         var payload: [String: Any] = [:]
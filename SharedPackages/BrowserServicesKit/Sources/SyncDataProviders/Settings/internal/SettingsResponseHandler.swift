@@ -56,7 +56,8 @@ final class SettingsResponseHandler {
         self.metricsEvents = metricsEvents
 
         let secretKey = try crypter.fetchSecretKey()
-        self.decrypt = { try crypter.base64DecodeAndDecrypt($0, using: secretKey) }
+        let decrypter = BatchDecrypter(values: self.received.compactMap(\.encryptedValue), crypter: crypter, secretKey: secretKey)
+        self.decrypt = { try decrypter.decrypt($0) }
 
         var syncablesByUUID: [String: SyncableSettingAdapter] = [:]
         var allUUIDs: Set<String> = []
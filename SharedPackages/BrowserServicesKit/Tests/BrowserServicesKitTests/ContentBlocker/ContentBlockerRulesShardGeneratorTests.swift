@@ -0,0 +1,177 @@
+//
+//  ContentBlockerRulesShardGeneratorTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+import TrackerRadarKit
+@testable import ContentBlocking
+
+final class ContentBlockerRulesShardGeneratorTests: XCTestCase {
+
+    var tds: TrackerData!
+
+    override func setUpWithError() throws {
+        tds = try JSONDecoder().decode(TrackerData.self, from: Self.mockTDS)
+    }
+
+    func testWhenShardsAreCombinedThenRulesMatchUnshardedBuilder() throws {
+        let generator = ContentBlockerRulesShardGenerator(shardCount: 4, cache: InMemoryContentBlockerRulesShardCache())
+        let allowList = [TrackerException(rule: "tracker.com/allowed.js", matching: .all),
+                         TrackerException(rule: "other.com/allowed.js", matching: .domains(["site.com"]))]
+
+        let output = try generator.generate(trackerData: tds,
+                                            unprotectedSites: ["unprotected.com"],
+                                            tempList: ["temp.com"],
+                                            allowList: allowList)
+        let sharded = try Self.encoded(try JSONDecoder().decode([ContentBlockerRule].self, from: output.encodedRules))
+
+        let unsharded = try Self.encoded(ContentBlockerRulesBuilder(trackerData: tds).buildRules(withExceptions: ["unprotected.com"],
+                                                                                                andTemporaryUnprotectedDomains: ["temp.com"],
+                                                                                                andTrackerAllowlist: allowList))
+        let blockRuleCount = ContentBlockerRulesBuilder(trackerData: tds).buildRules(withExceptions: nil,
+                                                                                    andTemporaryUnprotectedDomains: nil,
+                                                                                    andTrackerAllowlist: []).count
+
+        XCTAssertEqual(sharded.count, unsharded.count)
+        // Block rules of different trackers are independent of each other, their relative order follows the shards.
+        XCTAssertEqual(sharded.prefix(blockRuleCount).sorted(), unsharded.prefix(blockRuleCount).sorted())
+        // Allowlist and exception rules must follow every block rule, in the same order as in the unsharded list.
+        XCTAssertEqual(Array(sharded.dropFirst(blockRuleCount)), Array(unsharded.dropFirst(blockRuleCount)))
+        XCTAssertGreaterThan(sharded.count, blockRuleCount)
+    }
+
+    func testWhenInputsDoNotChangeThenNoShardIsRegenerated() throws {
+        let generator = ContentBlockerRulesShardGenerator(shardCount: 4, cache: InMemoryContentBlockerRulesShardCache())
+
+        let first = try generator.generate(trackerData: tds, unprotectedSites: [], tempList: [], allowList: [])
+        XCTAssertEqual(first.regeneratedShards.count, 4)
+
+        let second = try generator.generate(trackerData: tds, unprotectedSites: ["unprotected.com"], tempList: [], allowList: [])
+        XCTAssertTrue(second.regeneratedShards.isEmpty)
+        XCTAssertEqual(first.shardDigests, second.shardDigests)
+    }
+
+    func testWhenAllowlistChangesThenNoShardIsRegenerated() throws {
+        let generator = ContentBlockerRulesShardGenerator(shardCount: 4, cache: InMemoryContentBlockerRulesShardCache())
+        let first = try generator.generate(trackerData: tds, unprotectedSites: [], tempList: [], allowList: [])
+
+        let output = try generator.generate(trackerData: tds,
+                                            unprotectedSites: [],
+                                            tempList: [],
+                                            allowList: [TrackerException(rule: "sub.tracker.com/allowed.js", matching: .domains(["site.com"]))])
+
+        XCTAssertTrue(output.regeneratedShards.isEmpty)
+        XCTAssertEqual(output.shardDigests, first.shardDigests)
+        XCTAssertNotEqual(output.encodedRules, first.encodedRules)
+    }
+
+    func testWhenShardsAreStoredOnDiskThenNewGeneratorReusesThem() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        let first = try ContentBlockerRulesShardGenerator(shardCount: 4, cache: FileContentBlockerRulesShardCache(directory: directory))
+            .generate(trackerData: tds, unprotectedSites: [], tempList: [], allowList: [])
+        let second = try ContentBlockerRulesShardGenerator(shardCount: 4, cache: FileContentBlockerRulesShardCache(directory: directory))
+            .generate(trackerData: tds, unprotectedSites: [], tempList: [], allowList: [])
+
+        XCTAssertFalse(first.regeneratedShards.isEmpty)
+        XCTAssertTrue(second.regeneratedShards.isEmpty)
+        XCTAssertEqual(first.encodedRules, second.encodedRules)
+    }
+
+    func testWhenUnusedShardsAreRemovedThenOnlyShardsOfOtherOutputsAreDeleted() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = FileContentBlockerRulesShardCache(directory: directory)
+        let generator = ContentBlockerRulesShardGenerator(shardCount: 4, cache: cache)
+
+        let otherList = try generator.generate(trackerData: tds, unprotectedSites: [], tempList: [], allowList: [], listName: "other")
+        let old = try generator.generate(trackerData: tds, unprotectedSites: [], tempList: [], allowList: [], listName: "list")
+        var trackers = tds.trackers
+        trackers["tracker.com"] = nil
+        let updatedTDS = TrackerData(trackers: trackers, entities: tds.entities, domains: tds.domains, cnames: tds.cnames)
+        let new = try generator.generate(trackerData: updatedTDS, unprotectedSites: [], tempList: [], allowList: [], listName: "list")
+
+        generator.removeUnusedShards(keeping: new, listName: "list")
+
+        let removed = Set(old.shardDigests).subtracting(new.shardDigests)
+        XCTAssertFalse(removed.isEmpty)
+        for digest in removed {
+            XCTAssertNil(cache.rules(forDigest: digest, listName: "list"))
+        }
+        for digest in new.shardDigests {
+            XCTAssertNotNil(cache.rules(forDigest: digest, listName: "list"))
+        }
+        for digest in otherList.shardDigests {
+            XCTAssertNotNil(cache.rules(forDigest: digest, listName: "other"))
+        }
+    }
+
+    func testWhenArraysAreConcatenatedThenEmptyArraysAreSkipped() {
+        let result = ContentBlockerRulesShardGenerator.concatenate(encodedArrays: [Data("[]".utf8), Data("[1,2]".utf8), Data("[]".utf8), Data("[3]".utf8)])
+        XCTAssertEqual(String(data: result, encoding: .utf8), "[1,2,3]")
+    }
+
+    private static func encoded(_ rules: [ContentBlockerRule]) throws -> [String] {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+        return try rules.map { String(data: try encoder.encode($0), encoding: .utf8)! }
+    }
+
+}
+
+private extension ContentBlockerRulesShardGeneratorTests {
+
+    static let mockTDS = """
+    {
+        "trackers": {
+            "tracker.com": {
+                "domain": "tracker.com",
+                "default": "block",
+                "owner": { "name": "Tracker Inc", "displayName": "Tracker" }
+            },
+            "other.com": {
+                "domain": "other.com",
+                "default": "block",
+                "owner": { "name": "Other Inc", "displayName": "Other" },
+                "rules": [ { "rule": "other\\\\.com\\\\/ignored\\\\.js", "action": "ignore" } ]
+            },
+            "third.net": {
+                "domain": "third.net",
+                "default": "ignore",
+                "owner": { "name": "Third Inc", "displayName": "Third" },
+                "rules": [ { "rule": "third\\\\.net\\\\/pixel" } ]
+            }
+        },
+        "entities": {
+            "Tracker Inc": { "domains": ["tracker.com", "tracker-cdn.com"], "displayName": "Tracker", "prevalence": 1 },
+            "Other Inc": { "domains": ["other.com"], "displayName": "Other", "prevalence": 1 },
+            "Third Inc": { "domains": ["third.net"], "displayName": "Third", "prevalence": 1 }
+        },
+        "domains": {
+            "tracker.com": "Tracker Inc",
+            "tracker-cdn.com": "Tracker Inc",
+            "other.com": "Other Inc",
+            "third.net": "Third Inc"
+        },
+        "cnames": {
+            "cloaked.example.org": "sub.tracker.com"
+        }
+    }
+    """.data(using: .utf8)!
+
+}
@@ -0,0 +1,157 @@
+//
+//  TrackerDataIndexTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Common
+import XCTest
+import TrackerRadarKit
+@testable import BrowserServicesKit
+
+final class TrackerDataIndexTests: XCTestCase {
+
+    var tds: TrackerData!
+    var index: TrackerDataIndex!
+
+    override func setUpWithError() throws {
+        tds = try JSONDecoder().decode(TrackerData.self, from: Self.mockTDS)
+        index = TrackerDataIndex(trackerData: tds)
+    }
+
+    func testWhenHostIsSubdomainOfTrackerThenTrackerIsFound() {
+        XCTAssertEqual(index.findTracker(forHost: "a.b.tracker.com")?.domain, "tracker.com")
+        XCTAssertEqual(index.findTracker(forUrl: "https://sub.tracker.com/script.js")?.domain, "tracker.com")
+    }
+
+    func testWhenMoreSpecificTrackerExistsThenLongestSuffixWins() {
+        XCTAssertEqual(index.findTracker(forHost: "x.cdn.tracker.com")?.domain, "cdn.tracker.com")
+        XCTAssertEqual(index.findTracker(forHost: "cdn.tracker.com")?.domain, "cdn.tracker.com")
+    }
+
+    func testWhenOnlyTopLevelLabelMatchesThenNothingIsFound() {
+        XCTAssertNil(index.findTracker(forHost: "com"))
+        XCTAssertNil(index.findTracker(forHost: "other.com"))
+        XCTAssertNil(index.findEntity(forHost: "com"))
+    }
+
+    func testThatResultsMatchTrackerDataQueries() {
+        let hosts = ["tracker.com", "www.tracker.com", "cdn.tracker.com", "a.cdn.tracker.com",
+                     "www.owned.com", "owned.com", "cloaked.example.org", "example.org", "unknown.net", ""]
+
+        for host in hosts {
+            XCTAssertEqual(index.findTracker(forHost: host)?.domain, tds.findTracker(forUrl: "https://\(host)")?.domain, host)
+            XCTAssertEqual(index.findEntity(forHost: host)?.displayName, tds.findEntity(forHost: host)?.displayName, host)
+            XCTAssertEqual(index.findParentEntityOrFallback(forHost: host)?.displayName,
+                           tds.findParentEntityOrFallback(forHost: host)?.displayName, host)
+            XCTAssertEqual(index.findTrackerByCname(forHost: host)?.domain,
+                           tds.findTrackerByCname(forUrl: "https://\(host)")?.domain, host)
+        }
+    }
+
+    func testWhenTrackerIsOwnedByParentThenParentEntityIsReturned() {
+        XCTAssertEqual(index.findParentEntityOrFallback(forHost: "www.owned.com")?.displayName, "Tracker")
+        XCTAssertEqual(index.findEntity(forHost: "www.owned.com")?.displayName, "Owned")
+    }
+
+    func testWhenHostIsCnameThenCloakedTrackerIsReturned() {
+        let tracker = index.findTrackerByCname(forHost: "cloaked.example.org")
+        XCTAssertEqual(tracker?.domain, "cdn.tracker.com")
+        XCTAssertEqual(tracker?.owner?.displayName, "Tracker")
+    }
+
+    func testWhenHostsAreClassifiedInBatchThenResultsAreInOrder() {
+        let results = index.classify(hosts: ["unknown.net", "www.tracker.com", "cloaked.example.org"])
+
+        XCTAssertEqual(results.count, 3)
+        XCTAssertNil(results[0].tracker)
+        XCTAssertNil(results[0].entity)
+        XCTAssertEqual(results[1].tracker?.domain, "tracker.com")
+        XCTAssertEqual(results[1].entity?.displayName, "Tracker")
+        XCTAssertNil(results[1].cnameTracker)
+        XCTAssertNil(results[2].tracker)
+        XCTAssertEqual(results[2].cnameTracker?.domain, "cdn.tracker.com")
+    }
+
+    func testWhenManagerReloadsThenIndexIsRebuilt() {
+        let manager = TrackerDataManager(etag: nil,
+                                         data: nil,
+                                         embeddedDataProvider: MockEmbeddedDataProvider(data: Self.mockTDS, etag: "embedded"))
+        XCTAssertNotNil(manager.trackerDataIndex.findTracker(forHost: "tracker.com"))
+
+        manager.reload(etag: "new", data: TrackerDataManagerTests.exampleTDS.data(using: .utf8)!)
+        XCTAssertNil(manager.trackerDataIndex.findTracker(forHost: "tracker.com"))
+        XCTAssertNotNil(manager.trackerDataIndex.findTracker(forHost: "www.notreal.io"))
+
+        manager.reload(etag: nil, data: nil)
+        XCTAssertNotNil(manager.trackerDataIndex.findTracker(forHost: "tracker.com"))
+    }
+
+    func testWhenResolverUsesIndexThenDetectedRequestsMatchTrackerDataResolver() {
+        let tld = TLD()
+        let dataResolver = TrackerResolver(tds: tds, unprotectedSites: [], tempList: [], tld: tld)
+        let indexResolver = TrackerResolver(tdsIndex: index, unprotectedSites: [], tempList: [], tld: tld)
+
+        let requests = ["https://www.tracker.com/a.js", "https://x.cdn.tracker.com/b.js", "https://owned.com/c.js",
+                        "https://cloaked.example.org/d.js", "https://unknown.net/e.js"]
+        for pageUrl in ["https://example.com/", "https://www.tracker.com/", "https://owned.com/"] {
+            for requestUrl in requests {
+                let expected = dataResolver.trackerFromUrl(requestUrl, pageUrlString: pageUrl, resourceType: "script", potentiallyBlocked: true)
+                let actual = indexResolver.trackerFromUrl(requestUrl, pageUrlString: pageUrl, resourceType: "script", potentiallyBlocked: true)
+                XCTAssertEqual(actual?.url, expected?.url, "\(requestUrl) on \(pageUrl)")
+                XCTAssertEqual(actual?.entityName, expected?.entityName, "\(requestUrl) on \(pageUrl)")
+                XCTAssertEqual(actual?.state, expected?.state, "\(requestUrl) on \(pageUrl)")
+            }
+        }
+    }
+
+}
+
+private extension TrackerDataIndexTests {
+
+    static let mockTDS = """
+    {
+        "trackers": {
+            "tracker.com": {
+                "domain": "tracker.com",
+                "default": "block",
+                "owner": { "name": "Tracker Inc", "displayName": "Tracker" }
+            },
+            "cdn.tracker.com": {
+                "domain": "cdn.tracker.com",
+                "default": "block",
+                "owner": { "name": "Tracker Inc", "displayName": "Tracker" }
+            },
+            "owned.com": {
+                "domain": "owned.com",
+                "default": "ignore",
+                "owner": { "name": "Owned Inc", "displayName": "Owned", "ownedBy": "Tracker Inc" }
+            }
+        },
+        "entities": {
+            "Tracker Inc": { "domains": ["tracker.com"], "displayName": "Tracker", "prevalence": 1 },
+            "Owned Inc": { "domains": ["owned.com"], "displayName": "Owned", "prevalence": 1 }
+        },
+        "domains": {
+            "tracker.com": "Tracker Inc",
+            "owned.com": "Owned Inc"
+        },
+        "cnames": {
+            "cloaked.example.org": "cdn.tracker.com"
+        }
+    }
+    """.data(using: .utf8)!
+
+}
@@ -0,0 +1,65 @@
+//
+//  TrackingParametersMatcherTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import BrowserServicesKit
+
+final class TrackingParametersMatcherTests: XCTestCase {
+
+    let matcher = TrackingParametersMatcher(parameters: ["utm_source", "fbclid", "gclid", "a%20b"])
+
+    func testWhenNoParameterMatchesThenNilIsReturned() {
+        XCTAssertNil(matcher.removingTrackingParameters(from: "https://example.com/path?q=1&utm=2#utm_source"))
+        XCTAssertNil(matcher.removingTrackingParameters(from: "https://example.com/path#frag?fbclid=1"))
+        XCTAssertNil(matcher.removingTrackingParameters(from: "https://example.com/path"))
+    }
+
+    func testWhenParametersMatchThenTheyAreRemovedPreservingOrder() {
+        XCTAssertEqual(matcher.removingTrackingParameters(from: "https://example.com/?a=1&fbclid=2&b=3&gclid=4&c"),
+                       "https://example.com/?a=1&b=3&c")
+        XCTAssertEqual(matcher.removingTrackingParameters(from: "https://example.com/?fbclid=2&b=%20x+y"),
+                       "https://example.com/?b=%20x+y")
+    }
+
+    func testWhenAllParametersMatchThenQueryIsRemoved() {
+        XCTAssertEqual(matcher.removingTrackingParameters(from: "https://example.com/p?utm_source=x&gclid"),
+                       "https://example.com/p")
+    }
+
+    func testWhenUrlHasFragmentThenItIsPreserved() {
+        XCTAssertEqual(matcher.removingTrackingParameters(from: "https://example.com/?utm_source=x&q=1#section?gclid=1"),
+                       "https://example.com/?q=1#section?gclid=1")
+    }
+
+    func testThatNamesAreMatchedInPercentEncodedForm() {
+        XCTAssertEqual(matcher.removingTrackingParameters(from: "https://example.com/?a%20b=1&a b=2"),
+                       "https://example.com/?a b=2")
+        XCTAssertTrue(matcher.matches("fbclid"))
+        XCTAssertFalse(matcher.matches("FBCLID"))
+        XCTAssertFalse(matcher.matches("fbclid2"))
+    }
+
+    func testWhenQueryIsScannedThenOnlyParameterNamesAreMatched() {
+        XCTAssertTrue(matcher.containsTrackingParameters(inQuery: "a=1&fbclid=2"))
+        XCTAssertTrue(matcher.containsTrackingParameters(inQuery: "gclid"))
+        XCTAssertTrue(matcher.containsTrackingParameters(inQuery: "a%20b=1"))
+        XCTAssertFalse(matcher.containsTrackingParameters(inQuery: "q=fbclid&utm=2"))
+        XCTAssertFalse(matcher.containsTrackingParameters(inQuery: ""))
+    }
+
+}
@@ -0,0 +1,144 @@
+//
+//  PrivacyConfigurationDomainMatcherTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+import BrowserServicesKit
+
+final class PrivacyConfigurationDomainMatcherTests: XCTestCase {
+
+    private func makeData(tempUnprotected: [String],
+                          exceptions: [PrivacyFeature: [String]]) -> PrivacyConfigurationData {
+        var features = [PrivacyConfigurationData.FeatureName: PrivacyConfigurationData.PrivacyFeature]()
+        for (feature, domains) in exceptions {
+            features[feature.rawValue] = .init(state: PrivacyConfigurationData.State.enabled,
+                                               exceptions: domains.map { .init(domain: $0, reason: nil) })
+        }
+        return PrivacyConfigurationData(features: features,
+                                        unprotectedTemporary: tempUnprotected.map { .init(domain: $0, reason: nil) },
+                                        trackerAllowlist: [:])
+    }
+
+    func testWhenDomainOrParentIsListedThenItMatches() {
+        let matcher = PrivacyConfigurationDomainMatcher(data: makeData(tempUnprotected: ["Example.com", "sub.test.org", "  "],
+                                                                       exceptions: [:]))
+
+        XCTAssertTrue(matcher.isTempUnprotected(domain: "example.com"))
+        XCTAssertTrue(matcher.isTempUnprotected(domain: "www.example.com"))
+        XCTAssertTrue(matcher.isTempUnprotected(domain: "a.b.sub.test.org"))
+        XCTAssertFalse(matcher.isTempUnprotected(domain: "test.org"))
+        XCTAssertFalse(matcher.isTempUnprotected(domain: "notexample.com"))
+        XCTAssertFalse(matcher.isTempUnprotected(domain: "com"))
+        XCTAssertFalse(matcher.isTempUnprotected(domain: ""))
+    }
+
+    func testWhenTopLevelDomainIsListedThenItIsNotMatched() {
+        let matcher = PrivacyConfigurationDomainMatcher(data: makeData(tempUnprotected: ["com"], exceptions: [:]))
+
+        XCTAssertFalse(matcher.isTempUnprotected(domain: "example.com"))
+        XCTAssertFalse(matcher.isTempUnprotected(domain: "com"))
+    }
+
+    func testExceptionsAreScopedToFeature() {
+        let matcher = PrivacyConfigurationDomainMatcher(data: makeData(tempUnprotected: [],
+                                                                       exceptions: [.gpc: ["gpc.com"],
+                                                                                    .contentBlocking: ["cb.com"]]))
+
+        XCTAssertTrue(matcher.isInExceptionList(domain: "www.gpc.com", forFeature: .gpc))
+        XCTAssertFalse(matcher.isInExceptionList(domain: "www.gpc.com", forFeature: .contentBlocking))
+        XCTAssertTrue(matcher.isInExceptionList(domain: "cb.com", forFeature: .contentBlocking))
+        XCTAssertFalse(matcher.isInExceptionList(domain: "cb.com", forFeature: .autoconsent))
+    }
+
+    func testWhenUserUnprotectedDomainsChangeThenMatcherFollows() {
+        let matcher = PrivacyConfigurationDomainMatcher(data: makeData(tempUnprotected: [], exceptions: [:]))
+
+        XCTAssertTrue(matcher.isUserUnprotected(domain: "example.com", unprotectedDomains: ["Example.com"]))
+        XCTAssertFalse(matcher.isUserUnprotected(domain: "www.example.com", unprotectedDomains: ["Example.com"]))
+        XCTAssertFalse(matcher.isUserUnprotected(domain: "example.com", unprotectedDomains: ["other.com"]))
+        XCTAssertTrue(matcher.isUserUnprotected(domain: "other.com", unprotectedDomains: ["other.com"]))
+        XCTAssertFalse(matcher.isUserUnprotected(domain: "other.com", unprotectedDomains: []))
+    }
+
+    func testConfigurationUsesMatcherForFeatureChecks() {
+        let data = makeData(tempUnprotected: ["temp.com"], exceptions: [.gpc: ["exception.com"]])
+        let localProtection = MockDomainsProtectionStore()
+        let config = AppPrivacyConfiguration(data: data,
+                                             identifier: "",
+                                             localProtection: localProtection,
+                                             internalUserDecider: DefaultInternalUserDecider())
+
+        XCTAssertTrue(config.isFeature(.gpc, enabledForDomain: "example.com"))
+        XCTAssertFalse(config.isFeature(.gpc, enabledForDomain: "www.temp.com"))
+        XCTAssertFalse(config.isFeature(.gpc, enabledForDomain: "exception.com"))
+
+        localProtection.disableProtection(forDomain: "example.com")
+        XCTAssertFalse(config.isFeature(.gpc, enabledForDomain: "example.com"))
+        XCTAssertFalse(config.isProtected(domain: "example.com"))
+
+        localProtection.enableProtection(forDomain: "example.com")
+        XCTAssertTrue(config.isFeature(.gpc, enabledForDomain: "example.com"))
+    }
+
+    // MARK: - Benchmark
+
+    /// Embedded macOS configuration shipped with the app, located relative to this package inside the monorepo.
+    private static var embeddedConfigURL: URL {
+        URL(fileURLWithPath: #filePath)
+            .deletingLastPathComponent() // PrivacyConfig
+            .deletingLastPathComponent() // BrowserServicesKitTests
+            .deletingLastPathComponent() // Tests
+            .deletingLastPathComponent() // BrowserServicesKit
+            .deletingLastPathComponent() // SharedPackages
+            .deletingLastPathComponent()
+            .appendingPathComponent("macOS/DuckDuckGo/ContentBlocker/macos-config.json")
+    }
+
+    func testLookupPerformanceWithProductionSizedConfig() throws {
+        guard let configData = try? Data(contentsOf: Self.embeddedConfigURL) else {
+            throw XCTSkip("Embedded config is only available when the package is built inside the apps repository")
+        }
+        let data = try PrivacyConfigurationData(data: configData)
+        let features = data.features.keys.compactMap(PrivacyFeature.init(rawValue:))
+
+        let localProtection = MockDomainsProtectionStore()
+        localProtection.unprotectedDomains = Set((0..<50).map { "user\($0).example.net" })
+        let config = AppPrivacyConfiguration(data: data,
+                                             identifier: "benchmark",
+                                             localProtection: localProtection,
+                                             internalUserDecider: DefaultInternalUserDecider())
+
+        // Mix of unlisted hosts and subdomains of listed ones, so both the miss and the hit paths are measured.
+        let listedDomains = data.unprotectedTemporary.map(\.domain) + data.features.values.flatMap { $0.exceptions.map(\.domain) }
+        let hosts = (0..<1_000).map { "cdn.static.host\($0).some-long-site-name.co.uk" }
+            + listedDomains.prefix(200).map { "www." + $0 }
+            + ["user7.example.net"]
+
+        measure {
+            var disabledCount = 0
+            for _ in 0..<10 {
+                for host in hosts {
+                    for feature in features where !config.isFeature(feature, enabledForDomain: host) {
+                        disabledCount += 1
+                    }
+                }
+            }
+            XCTAssertGreaterThan(disabledCount, 0)
+        }
+    }
+
+}
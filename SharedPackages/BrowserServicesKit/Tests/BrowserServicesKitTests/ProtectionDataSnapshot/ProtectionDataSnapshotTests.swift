@@ -0,0 +1,344 @@
+//
+//  ProtectionDataSnapshotTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import BloomFilterWrapper
+import Combine
+import Common
+import Foundation
+import XCTest
+@testable import BrowserServicesKit
+
+final class ProtectionDataSnapshotTests: XCTestCase {
+
+    var directory: URL!
+    var snapshotURL: URL!
+
+    override func setUp() {
+        super.setUp()
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        snapshotURL = directory.appendingPathComponent("protection-data.snapshot")
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    private func makeSnapshot(_ build: (inout ProtectionDataSnapshotBuilder) throws -> Void, generation: UInt64 = 1) throws -> ProtectionDataSnapshot {
+        var builder = ProtectionDataSnapshotBuilder()
+        try build(&builder)
+        try builder.makeData(generation: generation).write(to: snapshotURL)
+        return try ProtectionDataSnapshot(contentsOf: snapshotURL)
+    }
+
+    func testWhenSnapshotIsBuiltThenDataSetsAreReadBack() throws {
+        let snapshot = try makeSnapshot({ builder in
+            try builder.addHTTPSExcludedDomains(["Example.com", "duckduckgo.com", "a.b.c"])
+            try builder.addMaliciousSiteHashPrefixes(["6fe1e7c8", "1d760415", "00000000"], revision: 42, threatKind: "phishing")
+            try builder.addMaliciousSiteFilters([(hash: "aa", regex: "r1"), (hash: "bb", regex: "r2"), (hash: "aa", regex: "r3")],
+                                                revision: 7, threatKind: "malware")
+        }, generation: 5)
+
+        XCTAssertEqual(snapshot.generation, 5)
+
+        let excludedDomains = try XCTUnwrap(snapshot.httpsExcludedDomains)
+        XCTAssertEqual(excludedDomains.count, 3)
+        XCTAssertTrue(excludedDomains.contains("example.com"))
+        XCTAssertTrue(excludedDomains.contains("a.b.c"))
+        XCTAssertFalse(excludedDomains.contains("b.c"))
+        XCTAssertEqual(excludedDomains.allStrings, ["a.b.c", "duckduckgo.com", "example.com"])
+
+        let prefixes = try XCTUnwrap(snapshot.maliciousSiteHashPrefixes(threatKind: "phishing"))
+        XCTAssertEqual(prefixes.revision, 42)
+        XCTAssertEqual(prefixes.count, 3)
+        XCTAssertTrue(prefixes.contains("6fe1e7c8"))
+        XCTAssertTrue(prefixes.contains("00000000"))
+        XCTAssertFalse(prefixes.contains("6fe1e7c9"))
+        XCTAssertFalse(prefixes.contains("6fe1e7c"))
+        XCTAssertEqual(Set(prefixes.allPrefixes), ["6fe1e7c8", "1d760415", "00000000"])
+        XCTAssertNil(snapshot.maliciousSiteHashPrefixes(threatKind: "malware"))
+
+        let filters = try XCTUnwrap(snapshot.maliciousSiteFilters(threatKind: "malware"))
+        XCTAssertEqual(filters.revision, 7)
+        XCTAssertEqual(filters.count, 3)
+        XCTAssertEqual(filters.keyCount, 2)
+        XCTAssertEqual(Set(filters.values(forKey: "aa")), ["r1", "r3"])
+        XCTAssertEqual(filters.values(forKey: "bb"), ["r2"])
+        XCTAssertEqual(filters.values(forKey: "cc"), [])
+        XCTAssertNil(snapshot.maliciousSiteFilters(threatKind: "phishing"))
+
+        XCTAssertNil(snapshot.httpsBloomFilter)
+        XCTAssertNil(snapshot.trackerData)
+    }
+
+    func testWhenHashPrefixesAreNotHexThenTheyAreStoredAsStrings() throws {
+        let snapshot = try makeSnapshot { builder in
+            try builder.addMaliciousSiteHashPrefixes(["sassa", "6fe1e7c8"], revision: 1, threatKind: "phishing")
+        }
+
+        let prefixes = try XCTUnwrap(snapshot.maliciousSiteHashPrefixes(threatKind: "phishing"))
+        XCTAssertTrue(prefixes.contains("sassa"))
+        XCTAssertTrue(prefixes.contains("6fe1e7c8"))
+        XCTAssertFalse(prefixes.contains("sass"))
+        XCTAssertEqual(Set(prefixes.allPrefixes), ["sassa", "6fe1e7c8"])
+    }
+
+    func testWhenBloomFilterIsQueriedInPlaceThenResultsMatchBloomFilterWrapper() throws {
+        // Random bits stand in for a populated filter: 8000 bits for 2000 entries use 3 hash rounds.
+        let bitCount = 8000, totalEntries = 2000
+        let data = Data((0..<(bitCount / 8)).map { _ in UInt8.random(in: 0...UInt8.max) })
+        let bloomFilterURL = directory.appendingPathComponent("bloom.bin")
+        try data.write(to: bloomFilterURL)
+        let specification = HTTPSBloomFilterSpecification(bitCount: bitCount, errorRate: 0.1, totalEntries: totalEntries, sha256: data.sha256)
+
+        let snapshot = try makeSnapshot { builder in
+            try builder.addHTTPSBloomFilter(specification: specification, data: data)
+        }
+        let bloomFilter = try XCTUnwrap(snapshot.httpsBloomFilter)
+        XCTAssertEqual(bloomFilter.specification, specification)
+
+        let wrapper = BloomFilterWrapper(fromPath: bloomFilterURL.path, withBitCount: Int32(bitCount), andTotalItems: Int32(totalEntries))
+        var matches = 0
+        for index in 0..<10_000 {
+            let host = index.isMultiple(of: 2) ? "host\(index).example.com" : UUID().uuidString + ".ÿé.com"
+            XCTAssertEqual(bloomFilter.contains(host), wrapper.contains(host), host)
+            if wrapper.contains(host) { matches += 1 }
+        }
+        // Both outcomes should have been exercised.
+        XCTAssertGreaterThan(matches, 0)
+        XCTAssertLessThan(matches, 10_000)
+    }
+
+    func testWhenBloomFilterDataIsShorterThanBitCountThenBuilderThrows() {
+        var builder = ProtectionDataSnapshotBuilder()
+        let specification = HTTPSBloomFilterSpecification(bitCount: 100, errorRate: 0.1, totalEntries: 10, sha256: "")
+        XCTAssertThrowsError(try builder.addHTTPSBloomFilter(specification: specification, data: Data(count: 12))) { error in
+            XCTAssertEqual(error as? ProtectionDataSnapshotBuilder.Error, .invalidBloomFilter)
+        }
+    }
+
+    func testWhenTrackerDataIsAddedThenItIsReadBackWithEtag() throws {
+        let tds = Data(#"{"trackers":{},"entities":{},"domains":{}}"#.utf8)
+        let snapshot = try makeSnapshot { builder in
+            try builder.addTrackerData(tds, etag: "\"etag\"")
+        }
+
+        let trackerData = try XCTUnwrap(snapshot.trackerData)
+        XCTAssertEqual(trackerData.etag, "\"etag\"")
+        XCTAssertEqual(trackerData.data, tds)
+    }
+
+    func testWhenFileIsNotASnapshotThenInitThrows() throws {
+        try Data("not a snapshot at all, just some text".utf8).write(to: snapshotURL)
+        XCTAssertThrowsError(try ProtectionDataSnapshot(contentsOf: snapshotURL)) { error in
+            XCTAssertEqual(error as? ProtectionDataSnapshot.Error, .invalidHeader)
+        }
+
+        XCTAssertThrowsError(try ProtectionDataSnapshot(contentsOf: directory.appendingPathComponent("missing"))) { error in
+            XCTAssertEqual(error as? ProtectionDataSnapshot.Error, .cannotOpenFile(errno: ENOENT))
+        }
+    }
+
+    func testWhenSnapshotIsTruncatedThenInitThrows() throws {
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSExcludedDomains(["example.com"])
+        let data = builder.makeData(generation: 1)
+
+        try data.prefix(data.count - 1).write(to: snapshotURL)
+        XCTAssertThrowsError(try ProtectionDataSnapshot(contentsOf: snapshotURL))
+    }
+
+    func testWhenSnapshotIsPublishedThenGenerationIncreasesAndStoreSwapsToIt() throws {
+        let notificationName = "com.duckduckgo.protection-data-snapshot.test.\(UUID().uuidString)"
+        let store = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: notificationName)
+        XCTAssertNil(store.snapshot)
+
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSExcludedDomains(["first.com"])
+        XCTAssertEqual(try builder.publish(to: snapshotURL, notificationName: notificationName), 1)
+        let first = try XCTUnwrap(store.reload())
+        XCTAssertEqual(first.generation, 1)
+        let firstDomains = try XCTUnwrap(first.httpsExcludedDomains)
+
+        var receivedGenerations = [UInt64]()
+        let cancellable = store.snapshotPublisher.sink { receivedGenerations.append($0.generation) }
+        defer { cancellable.cancel() }
+
+        builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSExcludedDomains(["second.com"])
+        XCTAssertEqual(try builder.publish(to: snapshotURL, notificationName: notificationName), 2)
+        store.reload()
+
+        XCTAssertEqual(store.snapshot?.generation, 2)
+        XCTAssertEqual(store.snapshot?.httpsExcludedDomains?.contains("second.com"), true)
+        XCTAssertEqual(receivedGenerations, [2])
+        // Data sets of the replaced generation stay readable.
+        XCTAssertTrue(firstDomains.contains("first.com"))
+
+        store.reload()
+        XCTAssertEqual(receivedGenerations, [2])
+    }
+
+    @MainActor
+    func testWhenSnapshotHasBloomFilterThenSnapshotStoreUsesIt() throws {
+        let data = Data(repeating: 0xFF, count: 16)
+        let specification = HTTPSBloomFilterSpecification(bitCount: 128, errorRate: 0.1, totalEntries: 10, sha256: data.sha256)
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSBloomFilter(specification: specification, data: data)
+        try builder.addHTTPSExcludedDomains(["excluded.com"])
+        try builder.publish(to: snapshotURL, notificationName: UUID().uuidString)
+
+        let fallbackStore = HTTPSUpgradeStoreMock(bloomFilter: nil, bloomFilterSpecification: nil, excludedDomains: ["fallback.com"])
+        let testee = SnapshotHTTPSUpgradeStore(snapshotStore: ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString),
+                                               fallbackStore: fallbackStore)
+
+        let bloomFilter = try XCTUnwrap(testee.loadBloomFilter())
+        XCTAssertEqual(bloomFilter.specification, specification)
+        XCTAssertTrue(bloomFilter.containsHost("anything.com"))
+        XCTAssertTrue(testee.hasExcludedDomain("Excluded.com"))
+        XCTAssertFalse(testee.hasExcludedDomain("fallback.com"))
+    }
+
+    func testWhenSnapshotIsMissingThenSnapshotStoreUsesFallback() {
+        let fallbackStore = HTTPSUpgradeStoreMock(bloomFilter: nil, bloomFilterSpecification: nil, excludedDomains: ["fallback.com"])
+        let testee = SnapshotHTTPSUpgradeStore(snapshotStore: ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString),
+                                               fallbackStore: fallbackStore)
+
+        XCTAssertNil(testee.loadBloomFilter())
+        XCTAssertTrue(testee.hasExcludedDomain("fallback.com"))
+    }
+
+    func testWhenDataIsPersistedThenSnapshotStoreUsesFallbackUntilItIsPublished() throws {
+        let notificationName = "com.duckduckgo.protection-data-snapshot.test.\(UUID().uuidString)"
+        let data = Data(repeating: 0xFF, count: 16)
+        let specification = HTTPSBloomFilterSpecification(bitCount: 128, errorRate: 0.1, totalEntries: 10, sha256: data.sha256)
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSBloomFilter(specification: specification, data: data)
+        try builder.addHTTPSExcludedDomains(["excluded.com"])
+        try builder.publish(to: snapshotURL, notificationName: notificationName)
+
+        let snapshotStore = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: notificationName)
+        let fallbackStore = PersistingHTTPSUpgradeStoreMock()
+        let testee = SnapshotHTTPSUpgradeStore(snapshotStore: snapshotStore, fallbackStore: fallbackStore)
+        XCTAssertEqual(testee.loadBloomFilter()?.specification, specification)
+
+        // WHEN
+        let updatedData = Data(repeating: 0x0F, count: 16)
+        let updatedSpecification = HTTPSBloomFilterSpecification(bitCount: 128, errorRate: 0.1, totalEntries: 10, sha256: updatedData.sha256)
+        try testee.persistBloomFilter(specification: updatedSpecification, data: updatedData)
+        try testee.persistExcludedDomains(["updated.com"])
+
+        // THEN
+        XCTAssertEqual(testee.loadBloomFilter()?.specification, updatedSpecification)
+        XCTAssertEqual(fallbackStore.loadBloomFilterCount, 1)
+        XCTAssertTrue(testee.hasExcludedDomain("updated.com"))
+        XCTAssertFalse(testee.hasExcludedDomain("excluded.com"))
+
+        // WHEN
+        builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSBloomFilter(specification: updatedSpecification, data: updatedData)
+        try builder.addHTTPSExcludedDomains(["updated.com", "published.com"])
+        try builder.publish(to: snapshotURL, notificationName: notificationName)
+        snapshotStore.reload()
+
+        // THEN
+        XCTAssertEqual(testee.loadBloomFilter()?.specification, updatedSpecification)
+        XCTAssertEqual(fallbackStore.loadBloomFilterCount, 1)
+        XCTAssertTrue(testee.hasExcludedDomain("published.com"))
+    }
+
+    func testWhenBuilderIsPublishedThenSectionsNotAddedToItAreKept() throws {
+        let notificationName = UUID().uuidString
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSExcludedDomains(["excluded.com"])
+        try builder.addMaliciousSiteHashPrefixes(["6fe1e7c8"], revision: 1, threatKind: "phishing")
+        try builder.publish(to: snapshotURL, notificationName: notificationName)
+
+        builder = ProtectionDataSnapshotBuilder()
+        try builder.addMaliciousSiteHashPrefixes(["1d760415"], revision: 2, threatKind: "phishing")
+        try builder.addMaliciousSiteHashPrefixes(["00000000"], revision: 3, threatKind: "malware")
+        try builder.publish(to: snapshotURL, notificationName: notificationName)
+
+        let snapshot = try ProtectionDataSnapshot(contentsOf: snapshotURL)
+        XCTAssertEqual(snapshot.generation, 2)
+        XCTAssertEqual(snapshot.httpsExcludedDomains?.allStrings, ["excluded.com"])
+        XCTAssertEqual(snapshot.maliciousSiteHashPrefixes(threatKind: "phishing")?.revision, 2)
+        XCTAssertEqual(snapshot.maliciousSiteHashPrefixes(threatKind: "phishing")?.allPrefixes, ["1d760415"])
+        XCTAssertEqual(snapshot.maliciousSiteHashPrefixes(threatKind: "malware")?.allPrefixes, ["00000000"])
+    }
+
+    func testWhenBuilderCopiesSnapshotThenAddedSectionsReplaceCopiedOnes() throws {
+        let snapshot = try makeSnapshot { builder in
+            try builder.addHTTPSExcludedDomains(["excluded.com"])
+            try builder.addTrackerData(Data("{}".utf8), etag: "etag")
+        }
+
+        var builder = ProtectionDataSnapshotBuilder(copying: snapshot)
+        XCTAssertTrue(builder.isEmpty)
+        try builder.addHTTPSExcludedDomains(["updated.com"])
+        try builder.makeData(generation: 2).write(to: snapshotURL)
+
+        let copy = try ProtectionDataSnapshot(contentsOf: snapshotURL)
+        XCTAssertEqual(copy.httpsExcludedDomains?.allStrings, ["updated.com"])
+        XCTAssertEqual(copy.trackerData?.etag, "etag")
+        XCTAssertEqual(copy.trackerData?.data, Data("{}".utf8))
+    }
+
+    func testWhenPublishingSnapshotStoreIsUpdatedThenUpdatesArePublished() throws {
+        let snapshotStore = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString)
+        let testee = SnapshotHTTPSUpgradeStore(snapshotStore: snapshotStore, fallbackStore: PersistingHTTPSUpgradeStoreMock(), publishesUpdates: true)
+        let data = Data(repeating: 0xFF, count: 16)
+        let specification = HTTPSBloomFilterSpecification(bitCount: 128, errorRate: 0.1, totalEntries: 10, sha256: data.sha256)
+
+        try testee.persistBloomFilter(specification: specification, data: data)
+        try testee.persistExcludedDomains(["updated.com"])
+
+        let snapshot = try XCTUnwrap(snapshotStore.snapshot)
+        XCTAssertEqual(snapshot.generation, 2)
+        XCTAssertEqual(snapshot.httpsBloomFilter?.specification, specification)
+        XCTAssertEqual(snapshot.httpsExcludedDomains?.allStrings, ["updated.com"])
+        XCTAssertTrue(testee.hasExcludedDomain("updated.com"))
+    }
+
+}
+
+private final class PersistingHTTPSUpgradeStoreMock: HTTPSUpgradeStore {
+
+    private var specification: HTTPSBloomFilterSpecification?
+    private var excludedDomains = Set<String>()
+    private(set) var loadBloomFilterCount = 0
+
+    func loadBloomFilter() -> BloomFilter? {
+        loadBloomFilterCount += 1
+        return specification.map { BloomFilter(wrapper: BloomFilterWrapper(totalItems: 10, errorRate: 0.1), specification: $0) }
+    }
+
+    func persistBloomFilter(specification: HTTPSBloomFilterSpecification, data: Data) throws {
+        self.specification = specification
+    }
+
+    func hasExcludedDomain(_ domain: String) -> Bool {
+        excludedDomains.contains(domain)
+    }
+
+    func persistExcludedDomains(_ domains: [String]) throws {
+        excludedDomains = Set(domains)
+    }
+
+}
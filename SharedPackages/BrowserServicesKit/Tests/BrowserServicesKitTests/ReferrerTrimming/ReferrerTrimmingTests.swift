@@ -77,6 +77,8 @@ class ReferrerTrimmingTests: XCTestCase {
         return try! JSONDecoder().decode(TrackerData.self, from: trackerJSON)
     }()
 
+    private lazy var trackerDataIndex = TrackerDataIndex(trackerData: tds)
+
     private lazy var referrerTestSuite: ReferrerTests = {
         let tests = Self.data.fromJsonFile(Resource.tests)
         return try! JSONDecoder().decode(ReferrerTests.self, from: tests)
@@ -100,7 +102,7 @@ class ReferrerTrimmingTests: XCTestCase {
             let referrerResult = referrerTrimming.getTrimmedReferrer(originUrl: URL(string: test.navigatingFromURL)!,
                                                                      destUrl: URL(string: test.navigatingToURL)!,
                                                                      referrerUrl: test.referrerValue != nil ? URL(string: test.referrerValue!) : nil,
-                                                                     trackerData: tds)
+                                                                     trackerDataIndex: trackerDataIndex)
 
             // nil result is considered unchanged
             let resultUrl = referrerResult == nil ? test.referrerValue : referrerResult
@@ -193,4 +193,108 @@ class DatabaseProviderTests: XCTestCase {
         XCTAssertEqual(1, try database.accounts().count)
     }
 
+    func test_when_accounts_are_queried_by_top_level_domain_then_subdomains_match() throws {
+        let database = try DefaultAutofillDatabaseProvider(key: simpleL1Key) as AutofillDatabaseProvider
+        for domain in ["example.com", "www.example.com", "a.b.Example.com", "notexample.com", "example.com.evil.org", "example.org"] {
+            let account = SecureVaultModels.WebsiteAccount(username: "brindy", domain: domain)
+            try database.storeWebsiteCredentials(SecureVaultModels.WebsiteCredentials(account: account, password: "password".data(using: .utf8)!))
+        }
+
+        let accounts = try database.websiteAccountsForTopLevelDomain("example.com")
+        XCTAssertEqual(accounts.map(\.domain), ["example.com", "www.example.com", "a.b.Example.com"])
+
+        let credentials = try database.websiteCredentialsForTopLevelDomain("example.com")
+        XCTAssertEqual(credentials.map(\.account.domain), ["example.com", "www.example.com", "a.b.Example.com"])
+
+        XCTAssertTrue(try database.websiteAccountsForTopLevelDomain("other.com").isEmpty)
+    }
+
+    func test_when_accounts_change_then_top_level_domain_results_are_updated() throws {
+        let database = try DefaultAutofillDatabaseProvider(key: simpleL1Key) as AutofillDatabaseProvider
+        let account = SecureVaultModels.WebsiteAccount(username: "brindy", domain: "www.example.com")
+        let accountId = try database.storeWebsiteCredentials(SecureVaultModels.WebsiteCredentials(account: account, password: "password".data(using: .utf8)!))
+        XCTAssertEqual(try database.websiteAccountsForTopLevelDomain("example.com").count, 1)
+
+        let otherAccount = SecureVaultModels.WebsiteAccount(username: "dax", domain: "login.example.com")
+        try database.storeWebsiteCredentials(SecureVaultModels.WebsiteCredentials(account: otherAccount, password: "password".data(using: .utf8)!))
+        XCTAssertEqual(try database.websiteAccountsForTopLevelDomain("example.com").count, 2)
+
+        var credentials = try XCTUnwrap(database.websiteCredentialsForAccountId(accountId))
+        credentials.account.domain = "example.org"
+        try database.storeWebsiteCredentials(credentials)
+        XCTAssertEqual(try database.websiteAccountsForTopLevelDomain("example.com").map(\.username), ["dax"])
+        XCTAssertEqual(try database.websiteAccountsForTopLevelDomain("example.org").map(\.username), ["brindy"])
+
+        try database.updateLastUsedForAccountId(accountId)
+        XCTAssertNotNil(try database.websiteAccountsForTopLevelDomain("example.org").first?.lastUsed)
+
+        try database.deleteAllWebsiteCredentials()
+        XCTAssertTrue(try database.websiteAccountsForTopLevelDomain("example.com").isEmpty)
+    }
+
+    func test_when_transaction_is_rolled_back_then_top_level_domain_results_are_unchanged() throws {
+        let database = try DefaultAutofillDatabaseProvider(key: simpleL1Key) as AutofillDatabaseProvider
+        XCTAssertTrue(try database.websiteAccountsForTopLevelDomain("example.com").isEmpty)
+
+        struct RollbackError: Error {}
+        XCTAssertThrowsError(try database.inTransaction { db in
+            let account = SecureVaultModels.WebsiteAccount(username: "brindy", domain: "example.com")
+            try database.storeWebsiteCredentials(SecureVaultModels.WebsiteCredentials(account: account, password: "password".data(using: .utf8)!), in: db)
+            throw RollbackError()
+        })
+
+        XCTAssertTrue(try database.websiteAccountsForTopLevelDomain("example.com").isEmpty)
+    }
+
+    func test_when_database_is_migrated_to_v14_then_existing_accounts_match_top_level_domain() throws {
+        do {
+            let database = try DefaultAutofillDatabaseProvider(key: simpleL1Key) { migrator in
+                migrator.registerMigration("v1", migrate: DefaultAutofillDatabaseProvider.migrateV1(database:))
+                migrator.registerMigration("v2", migrate: DefaultAutofillDatabaseProvider.migrateV2(database:))
+                migrator.registerMigration("v3", migrate: DefaultAutofillDatabaseProvider.migrateV3(database:))
+                migrator.registerMigration("v4", migrate: DefaultAutofillDatabaseProvider.migrateV4(database:))
+                migrator.registerMigration("v5", migrate: DefaultAutofillDatabaseProvider.migrateV5(database:))
+                migrator.registerMigration("v6", migrate: DefaultAutofillDatabaseProvider.migrateV6(database:))
+                migrator.registerMigration("v7", migrate: DefaultAutofillDatabaseProvider.migrateV7(database:))
+                migrator.registerMigration("v8", migrate: DefaultAutofillDatabaseProvider.migrateV8(database:))
+                migrator.registerMigration("v9", migrate: DefaultAutofillDatabaseProvider.migrateV9(database:))
+                migrator.registerMigration("v10", migrate: DefaultAutofillDatabaseProvider.migrateV10(database:))
+                migrator.registerMigration("v11", migrate: DefaultAutofillDatabaseProvider.migrateV11(database:))
+                migrator.registerMigration("v12", migrate: DefaultAutofillDatabaseProvider.migrateV12(database:))
+                migrator.registerMigration("v13", migrate: DefaultAutofillDatabaseProvider.migrateV13(database:))
+            }
+            try database.db.write {
+                try $0.execute(sql: "INSERT INTO website_accounts (username, domain, created, lastUpdated) VALUES (?, ?, ?, ?)",
+                               arguments: ["brindy", "WWW.Example.com", Date(), Date()])
+            }
+        }
+
+        let database = try DefaultAutofillDatabaseProvider(key: simpleL1Key)
+        let accounts = try database.websiteAccountsForTopLevelDomain("example.com")
+        XCTAssertEqual(accounts.map(\.domain), ["WWW.Example.com"])
+    }
+
+    func test_reversed_domain() {
+        XCTAssertEqual(SecureVaultModels.WebsiteAccount.reversedDomain("www.Example.com"), "com.example.www.")
+        XCTAssertEqual(SecureVaultModels.WebsiteAccount.reversedDomain("example.com"), "com.example.")
+        XCTAssertEqual(SecureVaultModels.WebsiteAccount.reversedDomain("localhost"), "localhost.")
+        XCTAssertNil(SecureVaultModels.WebsiteAccount.reversedDomain(nil))
+    }
+
+    func test_top_level_domain_lookup_performance() throws {
+        let database = try DefaultAutofillDatabaseProvider(key: simpleL1Key) as AutofillDatabaseProvider
+        try database.inTransaction { db in
+            for i in 0 ..< 5_000 {
+                let account = SecureVaultModels.WebsiteAccount(username: "user\(i)", domain: "login.site\(i % 1_000).com")
+                try database.storeWebsiteCredentials(SecureVaultModels.WebsiteCredentials(account: account, password: "password".data(using: .utf8)!), in: db)
+            }
+        }
+
+        measure {
+            for i in 0 ..< 1_000 {
+                XCTAssertEqual(try? database.websiteAccountsForTopLevelDomain("site\(i % 100).com").count, 5)
+            }
+        }
+    }
+
 }
@@ -0,0 +1,128 @@
+//
+//  TracerTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Common
+import XCTest
+
+final class TracerTests: XCTestCase {
+
+    override func setUp() {
+        super.setUp()
+        Tracer.reset()
+        Tracer.isEnabled = true
+    }
+
+    override func tearDown() {
+        Tracer.isEnabled = false
+        Tracer.reset()
+        super.tearDown()
+    }
+
+    private func exportedEvents() throws -> [[String: Any]] {
+        let json = try JSONSerialization.jsonObject(with: Tracer.exportChromeTrace()) as? [String: Any]
+        return try XCTUnwrap(json?["traceEvents"] as? [[String: Any]])
+    }
+
+    func testThatSpansAndCountersAreExportedAsChromeTraceEvents() throws {
+        let result = Tracer.span("TracerTests.span") {
+            Tracer.counter("TracerTests.counter", 42)
+            return 7
+        }
+        XCTAssertEqual(result, 7)
+
+        let events = try exportedEvents()
+        let span = try XCTUnwrap(events.first { $0["name"] as? String == "TracerTests.span" })
+        XCTAssertEqual(span["ph"] as? String, "X")
+        XCTAssertNotNil(span["ts"] as? Double)
+        XCTAssertNotNil(span["dur"] as? Double)
+
+        let counter = try XCTUnwrap(events.first { $0["name"] as? String == "TracerTests.counter" })
+        XCTAssertEqual(counter["ph"] as? String, "C")
+        XCTAssertEqual((counter["args"] as? [String: Any])?["value"] as? Int, 42)
+    }
+
+    func testWhenSpansAreRecordedOnManyThreads_eachThreadHasItsOwnEvents() throws {
+        let group = DispatchGroup()
+        for _ in 0..<4 {
+            group.enter()
+            Thread {
+                for _ in 0..<100 {
+                    Tracer.span("TracerTests.concurrent") {}
+                }
+                group.leave()
+            }.start()
+        }
+        group.wait()
+
+        let tids = try exportedEvents().filter { $0["name"] as? String == "TracerTests.concurrent" }.compactMap { $0["tid"] as? Int }
+        XCTAssertEqual(tids.count, 400)
+        XCTAssertEqual(Set(tids).count, 4)
+        // every thread's events are exported together from its own buffer
+        let tidRuns = tids.reduce(into: [Int]()) { runs, tid in
+            if runs.last != tid {
+                runs.append(tid)
+            }
+        }
+        XCTAssertEqual(tidRuns.count, 4)
+    }
+
+    func testWhenSpanEndsOnAnotherThread_itIsRecorded() async throws {
+        let span = Tracer.beginSpan("TracerTests.async")
+        try await Task.sleep(nanoseconds: 1_000_000)
+        await Task.detached { span.end() }.value
+
+        let event = try XCTUnwrap(try exportedEvents().first { $0["name"] as? String == "TracerTests.async" })
+        XCTAssertGreaterThanOrEqual(try XCTUnwrap(event["dur"] as? Double), 1000)
+    }
+
+    func testWhenDisabled_noEventsAreRecorded() throws {
+        Tracer.isEnabled = false
+        Tracer.span("TracerTests.disabled") {}
+        Tracer.counter("TracerTests.disabled", 1)
+
+        XCTAssertTrue(try exportedEvents().isEmpty)
+    }
+
+    func testWhenReset_previousEventsAreNotExported() throws {
+        Tracer.span("TracerTests.beforeReset") {}
+        Tracer.reset()
+        Tracer.span("TracerTests.afterReset") {}
+
+        XCTAssertEqual(try exportedEvents().compactMap { $0["name"] as? String }, ["TracerTests.afterReset"])
+    }
+
+    func testWhenRingBufferWrapsAround_onlyLatestEventsAreKept() throws {
+        for index in 0..<20_000 {
+            Tracer.counter("TracerTests.wrap", index)
+        }
+
+        let values = try exportedEvents().compactMap { ($0["args"] as? [String: Any])?["value"] as? Int }
+        XCTAssertLessThan(values.count, 20_000)
+        XCTAssertEqual(values.last, 19_999)
+    }
+
+    func testDisabledSpanOverhead() {
+        Tracer.isEnabled = false
+        measure {
+            for _ in 0..<1_000_000 {
+                Tracer.span("TracerTests.overhead") {}
+            }
+        }
+    }
+
+}
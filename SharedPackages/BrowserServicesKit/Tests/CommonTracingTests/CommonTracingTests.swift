@@ -0,0 +1,119 @@
+//
+//  CommonTracingTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CommonTracing
+import Foundation
+import XCTest
+
+final class CommonTracingTests: XCTestCase {
+
+    // event names must have static storage duration
+    private static let spanName: StaticString = "CommonTracingTests.span"
+    private static let counterName: StaticString = "CommonTracingTests.counter"
+
+    override func setUp() {
+        super.setUp()
+        ddg_trace_reset()
+        ddg_trace_set_enabled(true)
+    }
+
+    override func tearDown() {
+        ddg_trace_set_enabled(false)
+        ddg_trace_reset()
+        super.tearDown()
+    }
+
+    func testWhenSpanAndCounterAreRecorded_thenTheyAreExported() throws {
+        let start = ddg_trace_now()
+        ddg_trace_record_span(cString(Self.spanName), start)
+        ddg_trace_record_counter(cString(Self.counterName), 42)
+
+        let events = try exportedEvents()
+
+        let span = try XCTUnwrap(events.first { $0["name"] as? String == "\(Self.spanName)" })
+        XCTAssertEqual(span["ph"] as? String, "X")
+        XCTAssertNotNil(span["dur"] as? Double)
+        let counter = try XCTUnwrap(events.first { $0["name"] as? String == "\(Self.counterName)" })
+        XCTAssertEqual(counter["ph"] as? String, "C")
+        XCTAssertEqual((counter["args"] as? [String: Any])?["value"] as? Int, 42)
+    }
+
+    func testWhenTracingIsDisabled_thenEventsAreNotRecorded() throws {
+        ddg_trace_set_enabled(false)
+        ddg_trace_record_counter(cString(Self.counterName), 1)
+
+        XCTAssertTrue(try exportedEvents(named: Self.counterName).isEmpty)
+    }
+
+    func testWhenReset_thenEarlierEventsAreNotExported() throws {
+        ddg_trace_record_counter(cString(Self.counterName), 1)
+        // reset is based on timestamps: keep the events apart from it
+        waitForClockTick()
+        ddg_trace_reset()
+        waitForClockTick()
+        ddg_trace_record_counter(cString(Self.counterName), 2)
+
+        let values = try exportedEvents(named: Self.counterName).compactMap { ($0["args"] as? [String: Any])?["value"] as? Int }
+        XCTAssertEqual(values, [2])
+    }
+
+    func testWhenBufferWraps_thenOnlyLatestEventsAreExported() throws {
+        let capacity = Int(DDG_TRACE_THREAD_BUFFER_CAPACITY)
+        let eventCount = capacity + 10
+        for value in 0..<eventCount {
+            ddg_trace_record_counter(cString(Self.counterName), Int64(value))
+        }
+
+        let values = try exportedEvents(named: Self.counterName).compactMap { ($0["args"] as? [String: Any])?["value"] as? Int }
+        // the oldest slot is skipped as it may be being overwritten
+        XCTAssertEqual(values, Array((eventCount - capacity + 1)..<eventCount))
+    }
+
+    // MARK: - Helpers
+
+    private func waitForClockTick() {
+        let now = ddg_trace_now()
+        while ddg_trace_now() == now {}
+    }
+
+    private func cString(_ string: StaticString) -> UnsafePointer<CChar> {
+        UnsafeRawPointer(string.utf8Start).assumingMemoryBound(to: CChar.self)
+    }
+
+    private func exportedEvents(named name: StaticString) throws -> [[String: Any]] {
+        try exportedEvents().filter { $0["name"] as? String == "\(name)" }
+    }
+
+    private func exportedEvents() throws -> [[String: Any]] {
+        let output = TraceOutput()
+        withExtendedLifetime(output) {
+            ddg_trace_export_chrome_trace({ bytes, length, context in
+                guard let bytes, let context else { return }
+                Unmanaged<TraceOutput>.fromOpaque(context).takeUnretainedValue().data.append(UnsafeRawPointer(bytes).assumingMemoryBound(to: UInt8.self), count: length)
+            }, Unmanaged.passUnretained(output).toOpaque())
+        }
+
+        let trace = try XCTUnwrap(try JSONSerialization.jsonObject(with: output.data) as? [String: Any])
+        return try XCTUnwrap(trace["traceEvents"] as? [[String: Any]])
+    }
+
+}
+
+private final class TraceOutput {
+    var data = Data()
+}
@@ -0,0 +1,92 @@
+//
+//  CxaThrowSwapperTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@testable import Crashes
+import MachO
+import XCTest
+
+final class CxaThrowSwapperTests: XCTestCase {
+
+    private func loadedImageHeader(at index: UInt32) throws -> UnsafePointer<mach_header_64> {
+        try XCTUnwrap(_dyld_get_image_header(index).map(UnsafeRawPointer.init)?.assumingMemoryBound(to: mach_header_64.self))
+    }
+
+    func testWhenImagesAreDeferred_onlyFirstOneSchedulesDeferredHooking() throws {
+        let header1 = try loadedImageHeader(at: 0)
+        let header2 = try loadedImageHeader(at: 1)
+        var state = ImageProcessingState()
+
+        XCTAssertTrue(state.record(.deferred, duration: 0.001, header: header1, slide: 1, isDeferred: false))
+        XCTAssertFalse(state.record(.deferred, duration: 0.001, header: header2, slide: 2, isDeferred: false))
+        XCTAssertFalse(state.record(.hooked, duration: 0.001, header: header1, slide: 1, isDeferred: false))
+
+        XCTAssertEqual(state.deferredImages.map(\.header), [header1, header2])
+        XCTAssertEqual(state.deferredImages.map(\.slide), [1, 2])
+        XCTAssertEqual(state.statistics.deferredImageCount, 2)
+    }
+
+    func testWhenDeferredImagesAreTaken_queueIsEmptiedAndNextDeferredImageSchedulesHookingAgain() throws {
+        let header = try loadedImageHeader(at: 0)
+        var state = ImageProcessingState()
+        _ = state.record(.deferred, duration: 0, header: header, slide: 1, isDeferred: false)
+
+        let images = state.takeDeferredImages()
+
+        XCTAssertEqual(images.map(\.header), [header])
+        XCTAssertTrue(state.deferredImages.isEmpty)
+        XCTAssertTrue(state.record(.deferred, duration: 0, header: header, slide: 1, isDeferred: false))
+    }
+
+    func testWhenDeferredImageIsRemoved_itIsNotHookedLater() throws {
+        let header1 = try loadedImageHeader(at: 0)
+        let header2 = try loadedImageHeader(at: 1)
+        var state = ImageProcessingState()
+        _ = state.record(.deferred, duration: 0, header: header1, slide: 1, isDeferred: false)
+        _ = state.record(.deferred, duration: 0, header: header2, slide: 2, isDeferred: false)
+
+        state.removeDeferredImage(header: header1)
+        state.removeDeferredImage(header: header1)
+
+        XCTAssertEqual(state.takeDeferredImages().map(\.header), [header2])
+        XCTAssertEqual(state.statistics.deferredImageCount, 1)
+    }
+
+    func testWhenDeferredImagesAreProcessed_statisticsCountEachImageOnce() throws {
+        let header1 = try loadedImageHeader(at: 0)
+        let header2 = try loadedImageHeader(at: 1)
+        var state = ImageProcessingState()
+
+        _ = state.record(.skipped, duration: 0.001, header: nil, slide: 0, isDeferred: false)
+        _ = state.record(.failed, duration: 0.002, header: nil, slide: 0, isDeferred: false)
+        _ = state.record(.deferred, duration: 0.001, header: header1, slide: 1, isDeferred: false)
+        _ = state.record(.deferred, duration: 0.001, header: header2, slide: 2, isDeferred: false)
+        for image in state.takeDeferredImages() {
+            _ = state.record(.hooked, duration: 0.004, header: image.header, slide: image.slide, isDeferred: true)
+        }
+
+        let statistics = state.statistics
+        XCTAssertEqual(statistics.processedImageCount, 4)
+        XCTAssertEqual(statistics.skippedImageCount, 1)
+        XCTAssertEqual(statistics.failedImageCount, 1)
+        XCTAssertEqual(statistics.hookedImageCount, 2)
+        XCTAssertEqual(statistics.deferredImageCount, 0)
+        XCTAssertEqual(statistics.totalProcessingTime, 0.013, accuracy: 0.000001)
+        XCTAssertEqual(statistics.slowestImageProcessingTime, 0.004)
+    }
+
+}
@@ -0,0 +1,98 @@
+//
+//  CxxExceptionThrowStatisticsTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Common
+@testable import Crashes
+import CxxCrashHandler
+import XCTest
+
+final class CxxExceptionThrowStatisticsTests: XCTestCase {
+
+    private var stackSamplingInterval: UInt32 = 0
+
+    override func setUp() {
+        super.setUp()
+        stackSamplingInterval = CxxExceptionThrowStatistics.stackSamplingInterval
+        CxxExceptionThrowStatistics.isEnabled = true
+    }
+
+    override func tearDown() {
+        CxxExceptionThrowStatistics.isEnabled = false
+        CxxExceptionThrowStatistics.stackSamplingInterval = stackSamplingInterval
+        super.tearDown()
+    }
+
+    func testWhenThrowsAreRecordedOnManyThreads_countsAreAggregatedByType() {
+        let before = CxxExceptionThrowStatistics.snapshot()
+
+        DispatchQueue.concurrentPerform(iterations: 8) { _ in
+            for _ in 0..<1000 {
+                _recordTestCppExceptionThrow()
+            }
+        }
+
+        let statistics = CxxExceptionThrowStatistics.snapshot().subtracting(before)
+        XCTAssertEqual(statistics.throwCounts, ["TestException": 8000])
+        XCTAssertEqual(statistics.totalCount, 8000)
+        XCTAssertEqual(statistics.topTypes(1).first?.typeName, "TestException")
+    }
+
+    func testWhenDisabled_throwsAreNotCounted() {
+        CxxExceptionThrowStatistics.isEnabled = false
+        let before = CxxExceptionThrowStatistics.snapshot()
+
+        _recordTestCppExceptionThrow()
+
+        XCTAssertEqual(CxxExceptionThrowStatistics.snapshot().subtracting(before).totalCount, 0)
+    }
+
+    func testWhenEveryThrowIsSampled_allStacksAreCounted() throws {
+        CxxExceptionThrowStatistics.stackSamplingInterval = 1
+        let before = CxxExceptionThrowStatistics.snapshot()
+
+        for _ in 0..<10 {
+            _recordTestCppExceptionThrow()
+        }
+
+        let statistics = CxxExceptionThrowStatistics.snapshot().subtracting(before)
+        let sample = try XCTUnwrap(statistics.stackSamples.first)
+        XCTAssertEqual(statistics.stackSamples.reduce(0) { $0 + $1.count }, 10)
+        XCTAssertFalse(sample.addresses.isEmpty)
+        XCTAssertEqual(sample.symbols.count, sample.addresses.count)
+    }
+
+    func testWhenStatisticsPixelIsFired_onlyNewThrowsAreReported() {
+        var firedParameters = [[String: String]]()
+        let pixelEvents = EventMapping<CxxExceptionThrowStatistics.Event> { event, _, parameters, _ in
+            XCTAssertEqual(event, .cxxExceptionThrows)
+            firedParameters.append(parameters ?? [:])
+        }
+
+        var snapshot = CxxExceptionThrowStatistics.fireStatisticsPixel(since: CxxExceptionThrowStatistics.snapshot(), using: pixelEvents)
+        XCTAssertTrue(firedParameters.isEmpty)
+
+        _recordTestCppExceptionThrow()
+        _recordTestCppExceptionThrow()
+        snapshot = CxxExceptionThrowStatistics.fireStatisticsPixel(since: snapshot, using: pixelEvents)
+        XCTAssertEqual(firedParameters, [["count": "2", "types": "TestException:2"]])
+
+        CxxExceptionThrowStatistics.fireStatisticsPixel(since: snapshot, using: pixelEvents)
+        XCTAssertEqual(firedParameters.count, 1)
+    }
+
+}
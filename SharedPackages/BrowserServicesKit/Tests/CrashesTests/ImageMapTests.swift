@@ -0,0 +1,64 @@
+//
+//  ImageMapTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@testable import Crashes
+import CxxCrashHandler
+import MachO
+import XCTest
+
+final class ImageMapTests: XCTestCase {
+
+    private func loadedImageMaps() -> [(header: UnsafePointer<mach_header_64>, imageMap: ImageMap)] {
+        (0..<_dyld_image_count()).compactMap { index in
+            guard let header = _dyld_get_image_header(index).map(UnsafeRawPointer.init)?.assumingMemoryBound(to: mach_header_64.self),
+                  let imageMap = ImageMap(header: header, slide: _dyld_get_image_vmaddr_slide(index)) else { return nil }
+            return (header, imageMap)
+        }
+    }
+
+    func testWhenImageThrowsCxxExceptions_itImportsCxaThrow() throws {
+        // CxxCrashHandler is linked into the test image and throws in `_throwTestCppException`
+        let function: @convention(c) () -> Void = _recordTestCppExceptionThrow
+        let imageInfo = try Dl_info(unsafeBitCast(function, to: UnsafeRawPointer.self))
+        let imageMap = try XCTUnwrap(loadedImageMaps().first { UnsafeRawPointer($0.header) == UnsafeRawPointer(imageInfo.dli_fbase) }?.imageMap)
+
+        XCTAssertTrue(imageMap.importsSymbol(named: "___cxa_throw"))
+        XCTAssertFalse(imageMap.importsSymbol(named: "___cxa_throw_nonexistent"))
+    }
+
+    func testThatImagesNotImportingCxaThrowAreFilteredOut() {
+        let imageMaps = loadedImageMaps()
+        let importingCount = imageMaps.filter { $0.imageMap.importsSymbol(named: "___cxa_throw") }.count
+
+        XCTAssertGreaterThan(importingCount, 0)
+        XCTAssertLessThan(importingCount, imageMaps.count)
+    }
+
+    func testPrefilterPerformanceForAllLoadedImages() {
+        let imageMaps = loadedImageMaps()
+
+        measure {
+            for _ in 0..<10 {
+                for (_, imageMap) in imageMaps {
+                    _ = imageMap.importsSymbol(named: "___cxa_throw")
+                }
+            }
+        }
+    }
+
+}
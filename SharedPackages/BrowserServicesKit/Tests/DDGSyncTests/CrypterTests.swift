@@ -134,6 +134,54 @@ class CrypterTests: XCTestCase {
         XCTAssertEqual(try crypter.base64DecodeAndDecrypt(message), "")
     }
 
+    func testWhenEncryptingValuesInBatchThenResultsMatchInputOrderAndCanBeDecryptedOneByOne() throws {
+        let secretKey = Data([UInt8]((0 ..< DDGSYNCCRYPTO_SECRET_KEY_SIZE.rawValue).map { _ in UInt8.random(in: 0 ..< UInt8.max )}))
+        let crypter = Crypter(secureStore: SecureStorageStub())
+        let messages = (0 ..< Crypter.batchChunkSize * 3 + 7).map { "😆 \($0) " + String(repeating: "x", count: $0 % 50) } + ["", "same", "same"]
+
+        let encrypted = try crypter.encryptAndBase64Encode(messages, using: secretKey).map { try $0.get() }
+        XCTAssertEqual(encrypted.count, messages.count)
+        XCTAssertNotEqual(encrypted[encrypted.count - 1], encrypted[encrypted.count - 2])
+
+        for (message, encryptedMessage) in zip(messages, encrypted) {
+            XCTAssertEqual(try crypter.base64DecodeAndDecrypt(encryptedMessage, using: secretKey), message)
+        }
+        XCTAssertEqual(try crypter.base64DecodeAndDecrypt(encrypted, using: secretKey).map { try $0.get() }, messages)
+    }
+
+    func testWhenDecryptingValuesInBatchAndOneIsInvalidThenOnlyThatValueFails() throws {
+        let secretKey = Data([UInt8]((0 ..< DDGSYNCCRYPTO_SECRET_KEY_SIZE.rawValue).map { _ in UInt8.random(in: 0 ..< UInt8.max )}))
+        let crypter = Crypter(secureStore: SecureStorageStub())
+        let messages = (0 ..< 1000).map(String.init)
+        var encrypted = try crypter.encryptAndBase64Encode(messages, using: secretKey).map { try $0.get() }
+        encrypted[700] = "not base64 😆"
+
+        let decrypted = crypter.base64DecodeAndDecrypt(encrypted, using: secretKey)
+        XCTAssertEqual(decrypted.count, messages.count)
+        XCTAssertThrowsError(try decrypted[700].get())
+        for index in messages.indices where index != 700 {
+            XCTAssertEqual(try decrypted[index].get(), messages[index])
+        }
+        XCTAssertEqual(try crypter.base64DecodeAndDecrypt([""], using: secretKey).map { try $0.get() }, [""])
+    }
+
+    func testBatchEncryptionAndDecryptionPerformanceFor50kItems() throws {
+        let secretKey = Data([UInt8]((0 ..< DDGSYNCCRYPTO_SECRET_KEY_SIZE.rawValue).map { _ in UInt8.random(in: 0 ..< UInt8.max )}))
+        let crypter = Crypter(secureStore: SecureStorageStub())
+        // Bookmark-like payload: a title and a URL for each item.
+        let values = (0 ..< 25_000).flatMap { ["Bookmark title \($0)", "https://www.example\($0 % 977).com/some/path?id=\($0)"] }
+
+        measure {
+            do {
+                let encrypted = try crypter.encryptAndBase64Encode(values, using: secretKey).map { try $0.get() }
+                let decrypted = crypter.base64DecodeAndDecrypt(encrypted, using: secretKey)
+                XCTAssertEqual(decrypted.count, values.count)
+            } catch {
+                XCTFail("Unexpected error: \(error)")
+            }
+        }
+    }
+
     func assertValidBase64(_ base64: String) {
         for c in base64 {
             XCTAssertTrue(c.isLetter || c.isNumber || ["+", "/", "="].contains(c), "\(c) not valid base64 char")
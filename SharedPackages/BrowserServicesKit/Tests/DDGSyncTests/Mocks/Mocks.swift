@@ -396,6 +396,11 @@ class RemoteAPIRequestCreatingMock: RemoteAPIRequestCreating {
         createRequestCallArgs.append(CreateRequestCallArgs(url: url, method: method, headers: headers, parameters: parameters, body: body, contentType: contentType))
         return fakeRequests[url] ?? request
     }
+
+    func createRequest(url: URL, method: Networking.APIRequest.HTTPMethod, headers: [String: String], parameters: [String: String], bodyFileURL: URL, contentType: String?) -> HTTPRequesting {
+        let body = try? Data(contentsOf: bodyFileURL)
+        return createRequest(url: url, method: method, headers: headers, parameters: parameters, body: body, contentType: contentType)
+    }
 }
 
 class InspectableSyncRequestMaker: SyncRequestMaking {
@@ -0,0 +1,153 @@
+//
+//  SyncPayloadStreamingTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Gzip
+import NetworkingTestingUtils
+import XCTest
+
+@testable import DDGSync
+
+final class SyncPayloadStreamingTests: XCTestCase {
+
+    override func tearDown() {
+        MockURLProtocol.requestHandler = nil
+        super.tearDown()
+    }
+
+    private func makeRequest(count: Int) -> SyncRequest {
+        let syncables = (0..<count).map { index in
+            Syncable(jsonObject: ["id": "\(index)", "name": "bookmark \"\(index)\"", "url": "https://example.com/\(index)"])
+        }
+        return SyncRequest(feature: Feature(name: "bookmarks"), previousSyncTimestamp: "1234", sent: syncables)
+    }
+
+    private func readAll(from stream: InputStream, maxLength: Int = 4096) -> Data {
+        var data = Data()
+        var buffer = [UInt8](repeating: 0, count: maxLength)
+        stream.open()
+        defer { stream.close() }
+        while true {
+            let count = stream.read(&buffer, maxLength: buffer.count)
+            guard count > 0 else { break }
+            data.append(buffer, count: count)
+        }
+        return data
+    }
+
+    func testThatEncodedPayloadMatchesSerializedRequest() throws {
+        let request = makeRequest(count: 3)
+        let body = try SyncPatchPayloadEncoder(request: request, clientTimestamp: "2026-01-01T00:00:00Z").encode()
+
+        let expected: [String: Any] = [
+            "bookmarks": [
+                "updates": request.sent.map(\.payload),
+                "modified_since": "1234"
+            ],
+            "client_timestamp": "2026-01-01T00:00:00Z"
+        ]
+        let decoded = try XCTUnwrap(JSONSerialization.jsonObject(with: body) as? NSDictionary)
+        XCTAssertEqual(decoded, expected as NSDictionary)
+    }
+
+    func testThatEmptyRequestIsEncodedAsValidJSON() throws {
+        let body = try SyncPatchPayloadEncoder(request: makeRequest(count: 0), clientTimestamp: "now").encode()
+        let decoded = try XCTUnwrap(JSONSerialization.jsonObject(with: body) as? [String: Any])
+        XCTAssertEqual((decoded["bookmarks"] as? [String: Any])?["updates"] as? [NSDictionary], [])
+    }
+
+    func testWhenPayloadIsNotValidJSONThenEncoderThrows() {
+        let request = SyncRequest(feature: Feature(name: "bookmarks"), previousSyncTimestamp: nil, sent: [Syncable(jsonObject: ["date": Date()])])
+        XCTAssertThrowsError(try SyncPatchPayloadEncoder(request: request, clientTimestamp: "now"))
+    }
+
+    private func temporaryPayloadFiles() throws -> Set<String> {
+        Set(try FileManager.default.contentsOfDirectory(atPath: FileManager.default.temporaryDirectory.path).filter { $0.hasPrefix("sync-payload-") })
+    }
+
+    func testThatCompressedFileDecompressesToEncodedPayload() throws {
+        let encoder = try SyncPatchPayloadEncoder(request: makeRequest(count: 20_000), clientTimestamp: "now")
+        let fileURL = try SyncGzipPayloadCompressor().compressedFile(of: encoder.encode(_:))
+        defer { try? FileManager.default.removeItem(at: fileURL) }
+
+        let compressed = try Data(contentsOf: fileURL)
+        XCTAssertTrue(compressed.isGzipped)
+        XCTAssertEqual(try compressed.gunzipped(), try encoder.encode())
+    }
+
+    func testWhenPayloadWriterFailsThenErrorIsThrownAndFileIsRemoved() throws {
+        struct WriterError: Error {}
+        let filesBefore = try temporaryPayloadFiles()
+
+        XCTAssertThrowsError(try SyncGzipPayloadCompressor().compressedFile { write in
+            for _ in 0..<100 {
+                try write(Data((0..<1024).map { _ in UInt8.random(in: 0...UInt8.max) }))
+            }
+            throw WriterError()
+        }) { error in
+            XCTAssertTrue(error is WriterError)
+        }
+        XCTAssertEqual(try temporaryPayloadFiles(), filesBefore)
+    }
+
+    func testWhenRequestIsReleasedThenBodyFileIsRemoved() throws {
+        let fileURL = try SyncGzipPayloadCompressor().compressedFile { try $0(Data("{}".utf8)) }
+        var request: TemporaryBodyFileRequest? = TemporaryBodyFileRequest(request: HTTPRequestingMock(), bodyFileURL: fileURL)
+        XCTAssertNotNil(request)
+        XCTAssertTrue(FileManager.default.fileExists(atPath: fileURL.path))
+
+        request = nil
+        XCTAssertFalse(FileManager.default.fileExists(atPath: fileURL.path))
+    }
+
+    func testThatPatchRequestBodyIsUploadedFromFile() async throws {
+        let storage = SecureStorageStub()
+        try storage.persistAccount(SyncAccount(deviceId: "deviceId",
+                                               deviceName: "deviceName",
+                                               deviceType: "deviceType",
+                                               userId: "userId",
+                                               primaryKey: Data(),
+                                               secretKey: Data(),
+                                               token: "token",
+                                               state: .active))
+
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [MockURLProtocol.self]
+        let requestMaker = SyncRequestMaker(storage: storage,
+                                            api: RemoteAPIRequestCreator(urlSession: URLSession(configuration: configuration)),
+                                            endpoints: Endpoints(baseURL: URL(string: "https://sync.example.com")!),
+                                            payloadCompressor: SyncGzipPayloadCompressor())
+
+        var receivedPayload: BookmarksPayload?
+        var receivedHeaders: [String: String]?
+        MockURLProtocol.requestHandler = { request in
+            receivedHeaders = request.allHTTPHeaderFields
+            let stream = try XCTUnwrap(request.httpBodyStream)
+            receivedPayload = try JSONDecoder.snakeCaseKeys.decode(BookmarksPayload.self, from: self.readAll(from: stream).gunzipped())
+            let response = HTTPURLResponse(url: request.url!, statusCode: 200, httpVersion: nil, headerFields: nil)!
+            return (response, Data("{}".utf8))
+        }
+
+        let request = try requestMaker.makePatchRequest(with: makeRequest(count: 5_000), clientTimestamp: Date(), isCompressed: true)
+        let result = try await request.execute()
+
+        XCTAssertEqual(result.response.statusCode, 200)
+        XCTAssertEqual(receivedHeaders?["Content-Encoding"], "gzip")
+        XCTAssertEqual(receivedPayload?.bookmarks.updates.count, 5_000)
+        XCTAssertEqual(receivedPayload?.bookmarks.updates.last?.name, "bookmark \"4999\"")
+    }
+}
@@ -353,6 +353,81 @@ class HistoryCoordinatorTests: XCTestCase {
         waitForExpectations(timeout: 1.0)
     }
 
+    func testWhenDomainsAreBurnedRepeatedly_ThenIndexReflectsAddedAndRemovedEntries() {
+        let (historyStoringMock, historyCoordinator) = HistoryCoordinator.aHistoryCoordinator
+        let tld = TLD()
+
+        let url1 = URL(string: "https://duckduckgo.com")!
+        let url2 = URL(string: "https://example.com")!
+        historyCoordinator.addVisit(of: url1)
+        historyCoordinator.addVisit(of: url2)
+
+        let firstBurn = expectation(description: "First burn")
+        historyCoordinator.burnDomains(["duckduckgo.com"], tld: tld) { urls in
+            XCTAssertEqual(urls, [url1])
+            firstBurn.fulfill()
+        }
+        wait(for: [firstBurn], timeout: 1.0)
+
+        // Added after the index has been built
+        let url3 = URL(string: "https://sub.duckduckgo.com/page")!
+        historyCoordinator.addVisit(of: url3)
+
+        let secondBurn = expectation(description: "Second burn")
+        historyCoordinator.burnDomains(["duckduckgo.com", "example.com"], tld: tld) { urls in
+            XCTAssertEqual(urls, [url2, url3])
+            secondBurn.fulfill()
+        }
+        wait(for: [secondBurn], timeout: 1.0)
+
+        XCTAssertEqual(historyCoordinator.history?.count, 0)
+        XCTAssertEqual(Set(historyStoringMock.removeEntriesArray.map(\.url)), [url2, url3])
+    }
+
+    func testWhenLastEntryOfHostIsRemoved_ThenDomainIndexForgetsHost() {
+        var index = HistoryDomainIndex(tld: TLD(), entries: [])
+        let entry1 = HistoryEntry(url: URL(string: "https://sub.duckduckgo.com/a")!)
+        let entry2 = HistoryEntry(url: URL(string: "https://sub.duckduckgo.com/b")!)
+        let entry3 = HistoryEntry(url: URL(string: "https://duckduckgo.com")!)
+
+        index.insert(entry1)
+        index.insert(entry1)
+        index.insert(entry2)
+        index.insert(entry3)
+        XCTAssertEqual(index.hostCount, 2)
+
+        index.remove(entry1)
+        XCTAssertEqual(index.hostCount, 2)
+        index.remove(entry2)
+        XCTAssertEqual(index.hostCount, 1)
+        XCTAssertEqual(index.entries(forBaseDomains: ["duckduckgo.com"]), [entry3])
+
+        index.remove(entry3)
+        XCTAssertEqual(index.hostCount, 0)
+        XCTAssertTrue(index.entriesByBaseDomain.isEmpty)
+    }
+
+    func testWhenHistoryChanges_ThenDeltasArePublished() {
+        let (_, historyCoordinator) = HistoryCoordinator.aHistoryCoordinator
+
+        var changes = [String]()
+        let cancellable = historyCoordinator.historyChangesPublisher.sink { change in
+            switch change {
+            case .reloaded: changes.append("reloaded")
+            case .updated(let entry): changes.append("updated \(entry.url.host ?? "") \(entry.title ?? "")")
+            case .removed(let entries): changes.append("removed \(entries.map { $0.url.host ?? "" })")
+            }
+        }
+
+        let url = URL(string: "https://duckduckgo.com")!
+        historyCoordinator.addVisit(of: url)
+        historyCoordinator.updateTitleIfNeeded(title: "DDG", url: url)
+        historyCoordinator.removeUrlEntry(url)
+
+        XCTAssertEqual(changes, ["updated duckduckgo.com ", "updated duckduckgo.com DDG", "removed [\"duckduckgo.com\"]"])
+        cancellable.cancel()
+    }
+
 }
 
 fileprivate extension HistoryCoordinator {
@@ -16,6 +16,7 @@
 //  limitations under the License.
 //
 
+import BrowserServicesKit
 import Foundation
 import XCTest
 
@@ -313,6 +314,171 @@ class MaliciousSiteProtectionDataManagerTests: XCTestCase {
         await XCTAssertThrowsError(try await dataManager.store(FilterDictionary(revision: expectedRevision, items: expectedFilterSet), for: .filterSet(threatKind: .phishing)))
     }
 
+    func testWhenSnapshotRevisionIsNotOlderThanEmbeddedThenSnapshotDataIsUsedUntilUpdated() async throws {
+        // GIVEN
+        let snapshotURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: snapshotURL) }
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addMaliciousSiteHashPrefixes(["6fe1e7c8", "1d760415"], revision: 70, threatKind: ThreatKind.phishing.rawValue)
+        try builder.addMaliciousSiteFilters([(hash: "hash1", regex: "regex1"), (hash: "hash1", regex: "regex2")], revision: 70, threatKind: ThreatKind.phishing.rawValue)
+        try builder.addMaliciousSiteHashPrefixes(["aabbccdd"], revision: 64, threatKind: ThreatKind.malware.rawValue)
+        try builder.publish(to: snapshotURL, notificationName: UUID().uuidString)
+        let snapshotStore = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString)
+        dataManager = MaliciousSiteProtection.DataManager(fileStore: fileStore, embeddedDataProvider: embeddedDataProvider, fileNameProvider: { _ in "" }, snapshotStore: snapshotStore)
+
+        // WHEN
+        var hashPrefixes = await dataManager.dataSet(for: .hashPrefixes(threatKind: .phishing))
+        let filterSet = await dataManager.dataSet(for: .filterSet(threatKind: .phishing))
+        let outdatedHashPrefixes = await dataManager.dataSet(for: .hashPrefixes(threatKind: .malware))
+
+        // THEN
+        XCTAssertTrue(hashPrefixes.isSnapshotBacked)
+        XCTAssertEqual(hashPrefixes.revision, 70)
+        XCTAssertTrue(hashPrefixes.contains("6fe1e7c8"))
+        XCTAssertFalse(hashPrefixes.contains("aabb"))
+        XCTAssertTrue(filterSet.isSnapshotBacked)
+        XCTAssertEqual(filterSet, FilterDictionary(revision: 70, filters: ["hash1": ["regex1", "regex2"]]))
+        XCTAssertEqual(filterSet.count, 1)
+        XCTAssertFalse(outdatedHashPrefixes.isSnapshotBacked)
+        XCTAssertEqual(outdatedHashPrefixes.revision, embeddedDataProvider.embeddedRevision)
+
+        // WHEN
+        hashPrefixes.formUnion(["00000000"])
+
+        // THEN
+        XCTAssertFalse(hashPrefixes.isSnapshotBacked)
+        XCTAssertEqual(hashPrefixes.set, ["6fe1e7c8", "1d760415", "00000000"])
+    }
+
+    func testWhenSnapshotGenerationChangesThenDataSetsAreReloadedFromIt() async throws {
+        // GIVEN
+        let snapshotURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: snapshotURL) }
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addMaliciousSiteHashPrefixes(["6fe1e7c8"], revision: 70, threatKind: ThreatKind.phishing.rawValue)
+        try builder.publish(to: snapshotURL, notificationName: UUID().uuidString)
+        let snapshotStore = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString)
+        dataManager = MaliciousSiteProtection.DataManager(fileStore: fileStore, embeddedDataProvider: embeddedDataProvider, fileNameProvider: { _ in "" }, snapshotStore: snapshotStore)
+        let hashPrefixes = await dataManager.dataSet(for: .hashPrefixes(threatKind: .phishing))
+        XCTAssertEqual(hashPrefixes.revision, 70)
+
+        // WHEN
+        builder = ProtectionDataSnapshotBuilder()
+        try builder.addMaliciousSiteHashPrefixes(["1d760415"], revision: 71, threatKind: ThreatKind.phishing.rawValue)
+        try builder.publish(to: snapshotURL, notificationName: UUID().uuidString)
+        snapshotStore.reload()
+        let reloadedHashPrefixes = await dataManager.dataSet(for: .hashPrefixes(threatKind: .phishing))
+
+        // THEN
+        XCTAssertEqual(reloadedHashPrefixes.revision, 71)
+        XCTAssertTrue(reloadedHashPrefixes.contains("1d760415"))
+        XCTAssertFalse(reloadedHashPrefixes.contains("6fe1e7c8"))
+        // Data set of the previous generation stays readable.
+        XCTAssertTrue(hashPrefixes.contains("6fe1e7c8"))
+    }
+
+    func testWhenStoredRevisionIsNewerThanSnapshotThenStoredDataIsUsed() async throws {
+        // GIVEN
+        let snapshotURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: snapshotURL) }
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addMaliciousSiteHashPrefixes(["6fe1e7c8"], revision: 70, threatKind: ThreatKind.phishing.rawValue)
+        try builder.addMaliciousSiteHashPrefixes(["aabbccdd"], revision: 70, threatKind: ThreatKind.malware.rawValue)
+        try builder.publish(to: snapshotURL, notificationName: UUID().uuidString)
+        let fileNameProvider: MaliciousSiteProtection.DataManager.FileNameProvider = { dataType in
+            "\(dataType.threatKind.rawValue)\(Constants.hashPrefixesFileName)"
+        }
+        dataManager = MaliciousSiteProtection.DataManager(fileStore: fileStore, embeddedDataProvider: embeddedDataProvider, fileNameProvider: fileNameProvider)
+        try await dataManager.store(HashPrefixSet(revision: 71, items: ["1d760415"]), for: .hashPrefixes(threatKind: .phishing))
+        try await dataManager.store(HashPrefixSet(revision: 69, items: ["00000000"]), for: .hashPrefixes(threatKind: .malware))
+
+        // WHEN
+        let snapshotStore = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString)
+        dataManager = MaliciousSiteProtection.DataManager(fileStore: fileStore, embeddedDataProvider: embeddedDataProvider, fileNameProvider: fileNameProvider, snapshotStore: snapshotStore)
+        let phishingHashPrefixes = await dataManager.dataSet(for: .hashPrefixes(threatKind: .phishing))
+        let malwareHashPrefixes = await dataManager.dataSet(for: .hashPrefixes(threatKind: .malware))
+
+        // THEN
+        XCTAssertFalse(phishingHashPrefixes.isSnapshotBacked)
+        XCTAssertEqual(phishingHashPrefixes.revision, 71)
+        XCTAssertTrue(phishingHashPrefixes.contains("1d760415"))
+        XCTAssertTrue(malwareHashPrefixes.isSnapshotBacked)
+        XCTAssertEqual(malwareHashPrefixes.revision, 70)
+        XCTAssertTrue(malwareHashPrefixes.contains("aabbccdd"))
+    }
+
+    func testWhenDataSetsAreAddedToSnapshotThenTheyAreReadBack() async throws {
+        // GIVEN
+        let expectedHashPrefixes = Set(["6fe1e7c8", "sassa"])
+        let expectedFilters = FilterDictionary(revision: 66, items: [Filter(hash: "hash1", regex: "regex1"), Filter(hash: "hash2", regex: "regex2")])
+        try await dataManager.store(HashPrefixSet(revision: 66, items: expectedHashPrefixes), for: .hashPrefixes(threatKind: .phishing))
+        try await dataManager.store(expectedFilters, for: .filterSet(threatKind: .phishing))
+
+        // WHEN
+        var builder = ProtectionDataSnapshotBuilder()
+        try await dataManager.addDataSets(to: &builder, threatKinds: [.phishing])
+        let snapshotURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: snapshotURL) }
+        try builder.makeData(generation: 1).write(to: snapshotURL)
+        let snapshot = try ProtectionDataSnapshot(contentsOf: snapshotURL)
+
+        // THEN
+        XCTAssertEqual(HashPrefixSet(snapshot: snapshot, threatKind: .phishing)?.set, expectedHashPrefixes)
+        XCTAssertEqual(FilterDictionary(snapshot: snapshot, threatKind: .phishing), expectedFilters)
+        XCTAssertNil(HashPrefixSet(snapshot: snapshot, threatKind: .malware))
+    }
+
+    func testWhenPublishingDataManagerStoresDataSetThenItIsPublishedWithOtherSections() async throws {
+        // GIVEN
+        let snapshotURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: snapshotURL) }
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addHTTPSExcludedDomains(["excluded.com"])
+        try builder.addMaliciousSiteHashPrefixes(["6fe1e7c8"], revision: 70, threatKind: ThreatKind.phishing.rawValue)
+        try builder.publish(to: snapshotURL, notificationName: UUID().uuidString)
+        let snapshotStore = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString)
+        dataManager = MaliciousSiteProtection.DataManager(fileStore: fileStore, embeddedDataProvider: embeddedDataProvider, fileNameProvider: { _ in "" },
+                                                          snapshotStore: snapshotStore, publishesSnapshot: true)
+
+        // WHEN
+        try await dataManager.store(HashPrefixSet(revision: 71, items: ["1d760415"]), for: .hashPrefixes(threatKind: .phishing))
+
+        // THEN
+        let snapshot = try XCTUnwrap(snapshotStore.snapshot)
+        XCTAssertEqual(snapshot.generation, 2)
+        XCTAssertEqual(HashPrefixSet(snapshot: snapshot, threatKind: .phishing)?.revision, 71)
+        XCTAssertEqual(HashPrefixSet(snapshot: snapshot, threatKind: .phishing)?.set, ["1d760415"])
+        XCTAssertEqual(snapshot.httpsExcludedDomains?.allStrings, ["excluded.com"])
+    }
+
+    func testWhenDataSetsAreMissingFromSnapshotThenOnlyMissingOnesArePublished() async throws {
+        // GIVEN
+        let snapshotURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: snapshotURL) }
+        var builder = ProtectionDataSnapshotBuilder()
+        try builder.addMaliciousSiteHashPrefixes(["6fe1e7c8"], revision: 70, threatKind: ThreatKind.phishing.rawValue)
+        try builder.publish(to: snapshotURL, notificationName: UUID().uuidString)
+        let snapshotStore = ProtectionDataSnapshotStore(url: snapshotURL, notificationName: UUID().uuidString)
+        dataManager = MaliciousSiteProtection.DataManager(fileStore: fileStore, embeddedDataProvider: embeddedDataProvider, fileNameProvider: { _ in "" },
+                                                          snapshotStore: snapshotStore, publishesSnapshot: true)
+
+        // WHEN
+        await dataManager.publishMissingDataSets(threatKinds: [.phishing])
+
+        // THEN
+        let snapshot = try XCTUnwrap(snapshotStore.snapshot)
+        XCTAssertEqual(snapshot.generation, 2)
+        XCTAssertEqual(HashPrefixSet(snapshot: snapshot, threatKind: .phishing)?.revision, 70)
+        XCTAssertEqual(FilterDictionary(snapshot: snapshot, threatKind: .phishing)?.revision, embeddedDataProvider.embeddedRevision)
+        XCTAssertNil(HashPrefixSet(snapshot: snapshot, threatKind: .malware))
+
+        // WHEN
+        await dataManager.publishMissingDataSets(threatKinds: [.phishing])
+
+        // THEN
+        XCTAssertEqual(snapshotStore.snapshot?.generation, 2)
+    }
+
 }
 
 class MockMaliciousSiteProtectionFileStore: MaliciousSiteProtection.FileStoring {
@@ -0,0 +1,153 @@
+//
+//  SuggestionIndexTests.swift
+//
+//  Copyright © 2026 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import Suggestions
+
+final class SuggestionIndexTests: XCTestCase {
+
+    private let history: [HistoryEntryMock] = [
+        entry("https://www.duckduckgo.com/", title: "DuckDuckGo — Privacy, simplified."),
+        entry("https://news.ycombinator.com/item?id=1", title: "Hacker News"),
+        entry("https://www.testcase.com/notroot", title: "\"Cats and Dogs\""),
+        entry("https://example.com/path", title: nil),
+        entry("https://ru.wikipedia.org/wiki/1", title: "«Рукописи не горят»: первый замысел"),
+    ]
+
+    private let bookmarks: [BookmarkMock] = [
+        BookmarkMock(url: "https://spreadprivacy.com/", title: "Spread Privacy", isFavorite: true),
+        BookmarkMock(url: "https://www.apple.com/mac", title: "Mac - Apple", isFavorite: false),
+    ]
+
+    private let queries = ["d", "duck", "duckduckgo.com", "privacy", "simpl", "ycomb", "news hacker", "hac ne",
+                           "cats", "\"cats", "and", "dogs cats", "\"", "example", "ample.c", "рук", "«", "не го",
+                           "spread", "pple", "mac apple", "apple.com/m", "zzz", "www"]
+
+    func testThatCandidatesContainEveryScoredSuggestion() {
+        let index = SuggestionIndex()
+        index.updateHistory(history)
+        index.updateBookmarks(bookmarks)
+
+        for query in queries {
+            let lowerQuery = query.lowercased()
+            let candidates = index.candidates(for: query)
+
+            for entry in history where ScoringService.score(title: entry.title, url: entry.url, lowercasedQuery: lowerQuery) > 0 {
+                XCTAssertTrue(candidates.history.contains { $0.identifier == entry.identifier }, "\(query): \(entry.url)")
+            }
+            for bookmark in bookmarks where ScoringService.score(title: bookmark.title, url: URL(string: bookmark.url)!, lowercasedQuery: lowerQuery) > 0 {
+                XCTAssertTrue(candidates.bookmarks.contains { $0.url == bookmark.url }, "\(query): \(bookmark.url)")
+            }
+        }
+    }
+
+    func testWhenQueryDoesNotMatchAnyTokenThenNoCandidatesAreReturned() {
+        let index = SuggestionIndex()
+        index.updateHistory(history)
+        index.updateBookmarks(bookmarks)
+
+        let candidates = index.candidates(for: "hacker zzz")
+        XCTAssertTrue(candidates.history.isEmpty)
+        XCTAssertTrue(candidates.bookmarks.isEmpty)
+    }
+
+    func testWhenEntryTitleChangesThenItIsReindexed() {
+        let index = SuggestionIndex()
+        var entries = history
+        index.updateHistory(entries)
+        XCTAssertTrue(index.candidates(for: "lobsters").history.isEmpty)
+
+        entries[1].title = "Lobsters"
+        index.updateHistory(entries)
+
+        XCTAssertEqual(index.candidates(for: "lobsters").history.map(\.identifier), [entries[1].identifier])
+        XCTAssertTrue(index.candidates(for: "hacker").history.isEmpty)
+    }
+
+    func testWhenEntriesAreRemovedThenTheyAreNotReturned() {
+        let index = SuggestionIndex()
+        index.updateHistory(history)
+        index.updateBookmarks(bookmarks)
+        XCTAssertEqual(index.count, history.count + bookmarks.count)
+
+        index.updateHistory(Array(history.dropFirst()))
+        index.removeHistoryEntry(withIdentifier: history[1].identifier)
+        index.updateBookmarks([])
+
+        XCTAssertEqual(index.count, history.count - 2)
+        XCTAssertTrue(index.candidates(for: "duck").history.isEmpty)
+        XCTAssertTrue(index.candidates(for: "hacker").history.isEmpty)
+        XCTAssertTrue(index.candidates(for: "spread").bookmarks.isEmpty)
+    }
+
+    func testWhenIndexIsBuiltInBulkThenCandidatesMatchIncrementalUpdates() {
+        let bulk = SuggestionIndex()
+        bulk.updateHistory(history)
+
+        let incremental = SuggestionIndex()
+        history.forEach { incremental.updateHistoryEntry($0) }
+
+        for query in queries {
+            XCTAssertEqual(Set(bulk.candidates(for: query).history.map(\.identifier)),
+                           Set(incremental.candidates(for: query).history.map(\.identifier)),
+                           query)
+        }
+    }
+
+    func testWhenKeysAreRemovedAndAddedInOneBatchThenTheyStayQueryable() {
+        let index = SuggestionIndex()
+        index.updateHistory(history)
+
+        // The same keys are dropped with the old entry and added back with the new one within a single update.
+        let replacement = entry(history[0].url.absoluteString, title: history[0].title)
+        index.updateHistory(Array(history.dropFirst()) + [replacement])
+        XCTAssertEqual(index.candidates(for: "duck").history.map(\.identifier), [replacement.identifier])
+
+        index.removeHistoryEntries(withIdentifiers: [replacement.identifier, history[1].identifier])
+        XCTAssertTrue(index.candidates(for: "duck").history.isEmpty)
+        XCTAssertTrue(index.candidates(for: "hacker").history.isEmpty)
+        XCTAssertEqual(index.count, history.count - 2)
+    }
+
+    func testWhenTopScoredIsSelectedThenResultMatchesStableSortPrefix() {
+        let url = URL(string: "https://example.com")!
+        let scores = [5, 1, 9, 5, 3, 9, 0, 7, 5, 2]
+        let suggestions = scores.enumerated().map { ScoredSuggestion(kind: .historyEntry, url: url, title: "\($0.offset)", score: $0.element) }
+
+        let expected = suggestions.enumerated()
+            .sorted { $0.element.score != $1.element.score ? $0.element.score > $1.element.score : $0.offset < $1.offset }
+            .prefix(4)
+            .map(\.element.title)
+
+        XCTAssertEqual(suggestions.topScored(4).map(\.title), expected)
+        XCTAssertEqual(suggestions.topScored(100).count, suggestions.count)
+        XCTAssertTrue(suggestions.topScored(0).isEmpty)
+    }
+
+}
+
+private func entry(_ url: String, title: String?) -> HistoryEntryMock {
+    HistoryEntryMock(identifier: UUID(),
+                     url: URL(string: url)!,
+                     title: title,
+                     numberOfVisits: 1,
+                     lastVisit: Date(),
+                     failedToLoad: false,
+                     isDownload: false)
+}
@@ -21,6 +21,7 @@ import Foundation
 import BrowserServicesKit
 import Combine
 import Common
+import ContentBlocking
 import PixelExperimentKit
 
 public final class ContentBlocking {
@@ -75,6 +76,7 @@ public final class ContentBlocking {
         contentBlockingManager = ContentBlockerRulesManager(rulesSource: contentBlockerRulesSource,
                                                             exceptionsSource: exceptionsSource,
                                                             lastCompiledRulesStore: lastCompiledRulesStore,
+                                                            shardCache: Self.makeShardCache(),
                                                             errorReporting: Self.debugEvents)
 
         adClickAttributionRulesProvider = AdClickAttributionRulesProvider(config: adClickAttribution,
@@ -84,6 +86,11 @@ public final class ContentBlocking {
                                                                           compilationErrorReporting: Self.debugEvents)
     }
 
+    private static func makeShardCache() -> ContentBlockerRulesShardCaching? {
+        guard let cachesDirectory = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first else { return nil }
+        return FileContentBlockerRulesShardCache(directory: cachesDirectory.appendingPathComponent("ContentBlockerRulesShards", isDirectory: true))
+    }
+
     private static let debugEvents = EventMapping<ContentBlockerDebugEvents> { event, error, parameters, onComplete in
         let domainEvent: Pixel.Event
         var finalParameters = parameters ?? [:]
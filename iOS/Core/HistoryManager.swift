@@ -17,6 +17,7 @@
 //  limitations under the License.
 //
 
+import Combine
 import CoreData
 import Foundation
 import BrowserServicesKit
@@ -105,9 +106,10 @@ class NullHistoryCoordinator: HistoryCoordinating {
 
     var allHistoryVisits: [History.Visit]?
 
-    @Published private(set) public var historyDictionary: [URL: HistoryEntry]?
-    var historyDictionaryPublisher: Published<[URL: History.HistoryEntry]?>.Publisher {
-        $historyDictionary
+    private(set) public var historyDictionary: [URL: HistoryEntry]?
+
+    var historyChangesPublisher: AnyPublisher<HistoryChange, Never> {
+        Empty().eraseToAnyPublisher()
     }
 
     func addVisit(of url: URL) -> History.Visit? {
@@ -17,7 +17,9 @@
 //  limitations under the License.
 //
 
+import Combine
 import Core
+import CoreData
 import BrowserServicesKit
 import Suggestions
 import History
@@ -33,6 +35,7 @@ final class AutocompleteSuggestionsDataSource: SuggestionLoadingDataSource {
     private let bookmarksDatabase: CoreDataDatabase
     private let featureFlagger: FeatureFlagger
     private let tabsModel: TabsModel
+    private let suggestionIndexUpdater: SuggestionIndexUpdater?
 
     private var performSuggestionsRequest: SuggestionsRequest
 
@@ -59,11 +62,17 @@ final class AutocompleteSuggestionsDataSource: SuggestionLoadingDataSource {
         .mobile
     }
 
-    init(historyManager: HistoryManaging, bookmarksDatabase: CoreDataDatabase, featureFlagger: FeatureFlagger, tabsModel: TabsModel, performSuggestionsRequest: @escaping SuggestionsRequest) {
+    init(historyManager: HistoryManaging,
+         bookmarksDatabase: CoreDataDatabase,
+         featureFlagger: FeatureFlagger,
+         tabsModel: TabsModel,
+         suggestionIndexUpdater: SuggestionIndexUpdater? = nil,
+         performSuggestionsRequest: @escaping SuggestionsRequest) {
         self.historyManager = historyManager
         self.bookmarksDatabase = bookmarksDatabase
         self.featureFlagger = featureFlagger
         self.tabsModel = tabsModel
+        self.suggestionIndexUpdater = suggestionIndexUpdater
         self.performSuggestionsRequest = performSuggestionsRequest
     }
 
@@ -79,6 +88,12 @@ final class AutocompleteSuggestionsDataSource: SuggestionLoadingDataSource {
         return []
     }
 
+    func suggestionIndex(for suggestionLoading: Suggestions.SuggestionLoading) -> SuggestionIndex? {
+        // the index is only in sync with the history it was built from, which is replaced when history gets disabled
+        guard let suggestionIndexUpdater, suggestionIndexUpdater.historyCoordinator === historyCoordinator else { return nil }
+        return suggestionIndexUpdater.index
+    }
+
     func openTabs(for suggestionLoading: any SuggestionLoading) -> [BrowserTab] {
         if featureFlagger.isFeatureOn(.autocompleteTabs) {
             return candidateOpenTabs
@@ -98,3 +113,47 @@ final class AutocompleteSuggestionsDataSource: SuggestionLoadingDataSource {
     }
 
 }
+
+/// Keeps the autocomplete index in sync with history and bookmarks.
+final class SuggestionIndexUpdater {
+
+    let index = SuggestionIndex()
+    let historyCoordinator: HistoryCoordinating
+    private let bookmarksDatabase: CoreDataDatabase
+    private var cancellables = Set<AnyCancellable>()
+
+    init(historyCoordinator: HistoryCoordinating, bookmarksDatabase: CoreDataDatabase) {
+        self.historyCoordinator = historyCoordinator
+        self.bookmarksDatabase = bookmarksDatabase
+
+        index.updateHistory(historyCoordinator.history ?? [])
+        historyCoordinator.historyChangesPublisher
+            .sink { [index, weak historyCoordinator] change in
+                switch change {
+                case .reloaded:
+                    index.updateHistory(historyCoordinator?.history ?? [])
+                case .updated(let entry):
+                    index.updateHistoryEntry(entry)
+                case .removed(let entries):
+                    index.removeHistoryEntries(withIdentifiers: entries.map(\.identifier))
+                }
+            }
+            .store(in: &cancellables)
+
+        updateBookmarks()
+        NotificationCenter.default.publisher(for: NSManagedObjectContext.didSaveObjectsNotification)
+            .filter { [coordinator = bookmarksDatabase.coordinator] notification in
+                (notification.object as? NSManagedObjectContext)?.persistentStoreCoordinator == coordinator
+            }
+            .receive(on: DispatchQueue.main)
+            .sink { [weak self] _ in
+                self?.updateBookmarks()
+            }
+            .store(in: &cancellables)
+    }
+
+    private func updateBookmarks() {
+        index.updateBookmarks(CachedBookmarks(bookmarksDatabase).all)
+    }
+
+}
@@ -53,6 +53,7 @@ class AutocompleteViewController: UIHostingController<AutocompleteView> {
     private let historyManager: HistoryManaging
     private let bookmarksDatabase: CoreDataDatabase
     private let tabsModel: TabsModel
+    private let suggestionIndexUpdater: SuggestionIndexUpdater?
 
     private var task: URLSessionDataTask?
 
@@ -61,7 +62,8 @@ class AutocompleteViewController: UIHostingController<AutocompleteView> {
             historyManager: historyManager,
             bookmarksDatabase: bookmarksDatabase,
             featureFlagger: featureFlagger,
-            tabsModel: tabsModel) { [weak self] request, completion in
+            tabsModel: tabsModel,
+            suggestionIndexUpdater: suggestionIndexUpdater) { [weak self] request, completion in
                 self?.task = Self.session.dataTask(with: request) { data, _, error in
                     completion(data, error)
                 }
@@ -74,9 +76,11 @@ class AutocompleteViewController: UIHostingController<AutocompleteView> {
          appSettings: AppSettings,
          historyMessageManager: HistoryMessageManager = HistoryMessageManager(),
          tabsModel: TabsModel,
-         featureFlagger: FeatureFlagger) {
+         featureFlagger: FeatureFlagger,
+         suggestionIndexUpdater: SuggestionIndexUpdater? = nil) {
 
         self.tabsModel = tabsModel
+        self.suggestionIndexUpdater = suggestionIndexUpdater
         self.historyManager = historyManager
         self.bookmarksDatabase = bookmarksDatabase
 
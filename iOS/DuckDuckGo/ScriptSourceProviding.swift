@@ -98,7 +98,8 @@ struct DefaultScriptSourceProvider: ScriptSourceProviding {
                                                      trackerData: currentMainRules?.trackerData,
                                                      ctlTrackerData: nil,
                                                      tld: AppDependencyProvider.shared.storageCache.tld,
-                                                     trackerDataManager: ContentBlocking.shared.trackerDataManager)
+                                                     trackerDataManager: ContentBlocking.shared.trackerDataManager,
+                                                     trackerDataIndex: currentMainRules?.trackerDataIndex)
     }
 
     private static func buildSurrogatesConfig(contentBlockingManager: ContentBlockerRulesManagerProtocol,
@@ -113,7 +114,8 @@ struct DefaultScriptSourceProvider: ScriptSourceProviding {
                                                                  encodedSurrogateTrackerData: currentMainRules?.encodedTrackerData,
                                                                  trackerDataManager: ContentBlocking.shared.trackerDataManager,
                                                                  tld: AppDependencyProvider.shared.storageCache.tld,
-                                                                 isDebugBuild: isDebugBuild)
+                                                                 isDebugBuild: isDebugBuild,
+                                                                 trackerDataIndex: currentMainRules?.trackerDataIndex)
 
         return surrogatesConfig
     }
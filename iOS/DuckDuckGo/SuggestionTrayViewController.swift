@@ -52,6 +52,8 @@ class SuggestionTrayViewController: UIViewController {
     private let tabsModel: TabsModel
     private let featureFlagger: FeatureFlagger
     private let appSettings: AppSettings
+    /// Outlives autocomplete controllers, so the index is built once rather than on every query session
+    private var suggestionIndexUpdater: SuggestionIndexUpdater?
 
     var selectedSuggestion: Suggestion? {
         autocompleteController?.selectedSuggestion
@@ -251,13 +253,26 @@ class SuggestionTrayViewController: UIViewController {
                                                     bookmarksDatabase: bookmarksDatabase,
                                                     appSettings: appSettings,
                                                     tabsModel: tabsModel,
-                                                    featureFlagger: featureFlagger)
+                                                    featureFlagger: featureFlagger,
+                                                    suggestionIndexUpdater: currentSuggestionIndexUpdater())
         install(controller: controller)
         controller.delegate = autocompleteDelegate
         controller.presentationDelegate = self
         autocompleteController = controller
     }
 
+    private func currentSuggestionIndexUpdater() -> SuggestionIndexUpdater? {
+        // without history the old scoring path is used
+        guard historyManager.isHistoryFeatureEnabled(), historyManager.isEnabledByUser else { return nil }
+        let historyCoordinator = historyManager.historyCoordinator
+        if let suggestionIndexUpdater, suggestionIndexUpdater.historyCoordinator === historyCoordinator {
+            return suggestionIndexUpdater
+        }
+        let updater = SuggestionIndexUpdater(historyCoordinator: historyCoordinator, bookmarksDatabase: bookmarksDatabase)
+        suggestionIndexUpdater = updater
+        return updater
+    }
+
     private func removeAutocomplete() {
         guard let controller = autocompleteController else { return }
         controller.removeFromParent()
@@ -1145,7 +1145,7 @@ class TabViewController: UIViewController {
     public func makePrivacyInfo(url: URL, shouldCheckServerTrust: Bool = false) -> PrivacyInfo? {
         guard let host = url.host else { return nil }
         
-        let entity = ContentBlocking.shared.trackerDataManager.trackerData.findParentEntityOrFallback(forHost: host)
+        let entity = ContentBlocking.shared.trackerDataManager.trackerDataIndex.findParentEntityOrFallback(forHost: host)
 
         let privacyInfo = PrivacyInfo(url: url,
                                       parentEntity: entity,
@@ -85,20 +85,39 @@ final class AutocompleteSuggestionsDataSourceTests: XCTestCase {
         XCTAssertTrue(dataSource.internalPages(for: MockSuggestionLoading()).isEmpty)
     }
 
-    private func makeDataSource(tabsEnabled: Bool = true) -> AutocompleteSuggestionsDataSource {
+    func testWhenIndexIsBuiltFromCurrentHistory_ThenItIsProvided() {
+        let historyCoordinator = makeHistoryCoordinator()
+        let updater = SuggestionIndexUpdater(historyCoordinator: historyCoordinator, bookmarksDatabase: db)
+        let dataSource = makeDataSource(historyCoordinator: historyCoordinator, suggestionIndexUpdater: updater)
 
-        var mockHistoryCoordinator = MockHistoryCoordinator()
+        XCTAssertTrue(dataSource.suggestionIndex(for: MockSuggestionLoading()) === updater.index)
+    }
+
+    func testWhenIndexIsBuiltFromOtherHistory_ThenItIsNotProvided() {
+        let updater = SuggestionIndexUpdater(historyCoordinator: makeHistoryCoordinator(), bookmarksDatabase: db)
+        let dataSource = makeDataSource(suggestionIndexUpdater: updater)
+
+        XCTAssertNil(dataSource.suggestionIndex(for: MockSuggestionLoading()))
+    }
+
+    private func makeHistoryCoordinator() -> MockHistoryCoordinator {
+        let mockHistoryCoordinator = MockHistoryCoordinator()
         mockHistoryCoordinator.history = [
             makeHistory(.appStore, "App Store"),
             makeHistory(.mac, "DDG for macOS")
         ]
-        // mockHistoryCoordinator.
+        return mockHistoryCoordinator
+    }
 
+    private func makeDataSource(tabsEnabled: Bool = true,
+                                historyCoordinator: MockHistoryCoordinator? = nil,
+                                suggestionIndexUpdater: SuggestionIndexUpdater? = nil) -> AutocompleteSuggestionsDataSource {
         return AutocompleteSuggestionsDataSource(
-            historyManager: MockHistoryManager(historyCoordinator: mockHistoryCoordinator, isEnabledByUser: true, historyFeatureEnabled: true),
+            historyManager: MockHistoryManager(historyCoordinator: historyCoordinator ?? makeHistoryCoordinator(), isEnabledByUser: true, historyFeatureEnabled: true),
             bookmarksDatabase: db,
             featureFlagger: makeFeatureFlagger(tabsEnabled: tabsEnabled),
-            tabsModel: makeTabsModel()) { _, completion in
+            tabsModel: makeTabsModel(),
+            suggestionIndexUpdater: suggestionIndexUpdater) { _, completion in
                 completion("[]".data(using: .utf8), nil)
         }
     }
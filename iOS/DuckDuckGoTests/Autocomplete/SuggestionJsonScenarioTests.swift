@@ -19,6 +19,7 @@
 
 import Bookmarks
 import BrowserServicesKit
+import Combine
 import Common
 import Core
 import CoreData
@@ -379,9 +380,10 @@ extension SuggestionJsonScenarioTests {
         var history: [History.HistoryEntry]?
         var allHistoryVisits: [History.Visit]?
 
-        @Published var historyDictionary: [URL: History.HistoryEntry]?
-        var historyDictionaryPublisher: Published<[URL: History.HistoryEntry]?>.Publisher {
-            $historyDictionary
+        var historyDictionary: [URL: History.HistoryEntry]?
+
+        var historyChangesPublisher: AnyPublisher<HistoryChange, Never> {
+            Empty().eraseToAnyPublisher()
         }
 
         func loadHistory(onCleanFinished: @escaping () -> Void) {
@@ -112,6 +112,8 @@ final class AppDelegate: NSObject, NSApplicationDelegate {
         privacyStats: privacyStats,
         freemiumDBPPromotionViewCoordinator: freemiumDBPPromotionViewCoordinator
     )
+    private(set) lazy var suggestionIndexUpdater = SuggestionIndexUpdater(historyCoordinator: HistoryCoordinator.shared,
+                                                                         bookmarkManager: bookmarksManager)
     let privacyStats: PrivacyStatsCollecting
     let activeRemoteMessageModel: ActiveRemoteMessageModel
     let newTabPageCustomizationModel = NewTabPageCustomizationModel()
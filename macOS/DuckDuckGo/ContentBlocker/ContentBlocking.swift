@@ -21,6 +21,7 @@ import WebKit
 import Combine
 import BrowserServicesKit
 import Common
+import ContentBlocking
 import PixelKit
 import PixelExperimentKit
 
@@ -87,6 +88,7 @@ final class AppContentBlocking {
 
         contentBlockingManager = ContentBlockerRulesManager(rulesSource: contentBlockerRulesSource,
                                                             exceptionsSource: exceptionsSource,
+                                                            shardCache: Self.makeShardCache(),
                                                             cache: ContentBlockingRulesCache(),
                                                             errorReporting: Self.debugEvents)
         userContentUpdating = UserContentUpdating(contentBlockerRulesManager: contentBlockingManager,
@@ -103,6 +105,11 @@ final class AppContentBlocking {
                                                                           compilationErrorReporting: Self.debugEvents)
     }
 
+    private static func makeShardCache() -> ContentBlockerRulesShardCaching? {
+        guard let cachesDirectory = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first else { return nil }
+        return FileContentBlockerRulesShardCache(directory: cachesDirectory.appendingPathComponent("ContentBlockerRulesShards", isDirectory: true))
+    }
+
     private static let debugEvents = EventMapping<ContentBlockerDebugEvents> { event, error, parameters, onComplete in
         guard AppVersion.runType.requiresEnvironment else { return }
 
@@ -104,17 +104,18 @@ struct ScriptSourceProvider: ScriptSourceProviding {
     private func buildContentBlockerRulesConfig() -> ContentBlockerUserScriptConfig {
 
         let tdsName = DefaultContentBlockerRulesListsSource.Constants.trackerDataSetRulesListName
-        let trackerData = contentBlockingManager.currentRules.first(where: { $0.name == tdsName})?.trackerData
+        let trackerDataRules = contentBlockingManager.currentRules.first(where: { $0.name == tdsName})
 
         let ctlTrackerData = (contentBlockingManager.currentRules.first(where: {
             $0.name == DefaultContentBlockerRulesListsSource.Constants.clickToLoadRulesListName
         })?.trackerData)
 
         return DefaultContentBlockerUserScriptConfig(privacyConfiguration: privacyConfigurationManager.privacyConfig,
-                                                     trackerData: trackerData,
+                                                     trackerData: trackerDataRules?.trackerData,
                                                      ctlTrackerData: ctlTrackerData,
                                                      tld: tld,
-                                                     trackerDataManager: trackerDataManager)
+                                                     trackerDataManager: trackerDataManager,
+                                                     trackerDataIndex: trackerDataRules?.trackerDataIndex)
     }
 
     private func buildSurrogatesConfig() -> SurrogatesUserScriptConfig {
@@ -128,13 +129,22 @@ struct ScriptSourceProvider: ScriptSourceProviding {
 
         let surrogates = configStorage.loadData(for: .surrogates)?.utf8String() ?? ""
         let allTrackers = mergeTrackerDataSets(rules: contentBlockingManager.currentRules)
+        // The compiled rules’ index only covers the main tracker data set: with click-to-load trackers merged in,
+        // lookups go through the merged tracker data instead.
+        let hasClickToLoadRules = contentBlockingManager.currentRules.contains {
+            $0.name == DefaultContentBlockerRulesListsSource.Constants.clickToLoadRulesListName
+        }
+        let trackerDataIndex = hasClickToLoadRules ? nil : contentBlockingManager.currentRules.first {
+            $0.name == DefaultContentBlockerRulesListsSource.Constants.trackerDataSetRulesListName
+        }?.trackerDataIndex
         return DefaultSurrogatesUserScriptConfig(privacyConfig: privacyConfigurationManager.privacyConfig,
                                                  surrogates: surrogates,
                                                  trackerData: allTrackers.trackerData,
                                                  encodedSurrogateTrackerData: allTrackers.encodedTrackerData,
                                                  trackerDataManager: trackerDataManager,
                                                  tld: tld,
-                                                 isDebugBuild: isDebugBuild)
+                                                 isDebugBuild: isDebugBuild,
+                                                 trackerDataIndex: trackerDataIndex)
     }
 
     @MainActor
@@ -41,3 +41,18 @@ extension CrashReportSender {
         }
     }
 }
+
+extension CxxExceptionThrowStatistics {
+
+    static let pixelEvents: EventMapping<Event> = .init { event, _, parameters, _ in
+        switch event {
+        case .cxxExceptionThrows:
+            PixelKit.fire(DebugEvent(GeneralPixel.cxxExceptionThrows),
+                          frequency: .standard,
+                          withHeaders: [:],
+                          withAdditionalParameters: parameters,
+                          withError: nil,
+                          allowedQueryReservedCharacters: nil)
+        }
+    }
+}
@@ -138,7 +138,15 @@ public class MaliciousSiteProtectionManager: MaliciousSiteDetecting {
         let dataManager = dataManager ?? {
             let configurationUrl = FileManager.default.configurationDirectory()
             let fileStore = MaliciousSiteProtection.FileStore(dataStoreURL: configurationUrl)
-            return MaliciousSiteProtection.DataManager(fileStore: fileStore, embeddedDataProvider: embeddedDataProvider, fileNameProvider: Self.fileName(for:))
+            let dataManager = MaliciousSiteProtection.DataManager(fileStore: fileStore,
+                                                                  embeddedDataProvider: embeddedDataProvider,
+                                                                  fileNameProvider: Self.fileName(for:),
+                                                                  snapshotStore: AppPrivacyFeatures.protectionDataSnapshotStore,
+                                                                  publishesSnapshot: true)
+            Task.detached(priority: .utility) {
+                await dataManager.publishMissingDataSets()
+            }
+            return dataManager
         }()
 
         let supportedThreatsProvider = {
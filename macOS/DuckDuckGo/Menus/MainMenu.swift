@@ -760,6 +760,12 @@ final class MainMenu: NSMenu {
                 NSMenuItem(title: "C++ exception", action: #selector(MainViewController.crashOnCxxException))
             }
 
+            NSMenuItem(title: "C++ Exception Throws") {
+                NSMenuItem(title: "Count Throws", action: #selector(MainViewController.toggleCxxExceptionThrowStatistics))
+                NSMenuItem(title: "Show Statistics", action: #selector(MainViewController.showCxxExceptionThrowStatistics))
+                NSMenuItem(title: "Fire Statistics Pixel", action: #selector(MainViewController.fireCxxExceptionThrowStatisticsPixel))
+            }
+
             let subscriptionAppGroup = Bundle.main.appGroup(bundle: .subs)
             let subscriptionUserDefaults = UserDefaults(suiteName: subscriptionAppGroup)!
 
@@ -885,6 +885,21 @@ extension MainViewController {
         throwTestCppException()
     }
 
+    @objc func toggleCxxExceptionThrowStatistics(_ sender: Any?) {
+        CxxExceptionThrowStatistics.isEnabled.toggle()
+    }
+
+    @objc func showCxxExceptionThrowStatistics(_ sender: Any?) {
+        let alert = NSAlert()
+        alert.messageText = "C++ Exception Throws"
+        alert.informativeText = CxxExceptionThrowStatistics.snapshot().debugDescription
+        alert.runModal()
+    }
+
+    @objc func fireCxxExceptionThrowStatisticsPixel(_ sender: Any?) {
+        CxxExceptionThrowStatistics.fireStatisticsPixel(since: nil, using: CxxExceptionThrowStatistics.pixelEvents)
+    }
+
     @objc func resetSecureVaultData(_ sender: Any?) {
         let vault = try? AutofillSecureVaultFactory.makeVault(reporter: SecureVaultReporter.shared)
 
@@ -1249,6 +1264,11 @@ extension MainViewController: NSMenuItemValidation {
 
             return true
 
+        // Debug
+        case #selector(MainViewController.toggleCxxExceptionThrowStatistics(_:)):
+            menuItem.state = CxxExceptionThrowStatistics.isEnabled ? .on : .off
+            return true
+
         default:
             return true
         }
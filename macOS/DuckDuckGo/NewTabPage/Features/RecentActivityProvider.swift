@@ -78,7 +78,8 @@ final class RecentActivityProvider: NewTabPageRecentActivityProviding {
         self.duckPlayerHistoryEntryTitleProvider = duckPlayerHistoryEntryTitleProvider
         self.trackerEntityPrevalenceComparator = trackerEntityPrevalenceComparator
 
-        activityPublisher = historyCoordinator.historyDictionaryPublisher
+        activityPublisher = historyCoordinator.historyChangesPublisher
+            .prepend(.reloaded)
             .receive(on: DispatchQueue.main)
             .compactMap { [weak historyCoordinator] _ -> BrowsingHistory? in
                 historyCoordinator?.history
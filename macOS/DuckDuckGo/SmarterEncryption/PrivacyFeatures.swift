@@ -17,6 +17,7 @@
 //
 
 import BrowserServicesKit
+import Combine
 import Common
 import Foundation
 import Persistence
@@ -43,6 +44,10 @@ final class AppPrivacyFeatures: PrivacyFeaturesProtocol {
     let contentBlocking: AnyContentBlocking
     let httpsUpgrade: HTTPSUpgrade
 
+    /// Protection data published by the app to the app configuration group container, shared with the VPN agent
+    static let protectionDataSnapshotStore = ProtectionDataSnapshotStore(url: FileManager.default.configurationDirectory().appendingPathComponent("ProtectionData.snapshot"))
+    private var protectionDataSnapshotCancellable: AnyCancellable?
+
     private static let httpsUpgradeDebugEvents = EventMapping<AppHTTPSUpgradeStore.ErrorEvents> { event, error, parameters, onComplete in
         let domainEvent: GeneralPixel
         let dailyAndCount: Bool
@@ -87,8 +92,22 @@ final class AppPrivacyFeatures: PrivacyFeaturesProtocol {
 
     convenience init(contentBlocking: AnyContentBlocking, database: CoreDataDatabase) {
         let bloomFilterDataURL = URL.sandboxApplicationSupportURL.appendingPathComponent("HttpsBloomFilter.bin")
-        let httpsUpgradeStore = AppHTTPSUpgradeStore(database: database, bloomFilterDataURL: bloomFilterDataURL, embeddedResources: Self.embeddedBloomFilterResources, errorEvents: Self.httpsUpgradeDebugEvents, logger: Logger.httpsUpgrade)
+        let appHTTPSUpgradeStore = AppHTTPSUpgradeStore(database: database, bloomFilterDataURL: bloomFilterDataURL, embeddedResources: Self.embeddedBloomFilterResources, errorEvents: Self.httpsUpgradeDebugEvents, logger: Logger.httpsUpgrade)
+        let snapshotStore = Self.protectionDataSnapshotStore
+        let httpsUpgradeStore = SnapshotHTTPSUpgradeStore(snapshotStore: snapshotStore, fallbackStore: appHTTPSUpgradeStore, publishesUpdates: true)
         self.init(contentBlocking: contentBlocking, httpsUpgradeStore: httpsUpgradeStore)
+
+        // release the Bloom filter of the replaced snapshot generation
+        protectionDataSnapshotCancellable = snapshotStore.snapshotPublisher
+            .sink { [weak httpsUpgrade = self.httpsUpgrade] _ in
+                httpsUpgrade?.loadDataAsync()
+            }
+
+        if snapshotStore.snapshot?.httpsBloomFilter == nil || snapshotStore.snapshot?.httpsExcludedDomains == nil {
+            DispatchQueue.global(qos: .utility).async {
+                Self.publishStoredHTTPSUpgradeData(from: appHTTPSUpgradeStore, to: snapshotStore)
+            }
+        }
     }
 
     init(contentBlocking: AnyContentBlocking, httpsUpgradeStore: HTTPSUpgradeStore) {
@@ -96,4 +115,15 @@ final class AppPrivacyFeatures: PrivacyFeaturesProtocol {
         self.httpsUpgrade = HTTPSUpgrade(store: httpsUpgradeStore, privacyManager: contentBlocking.privacyConfigurationManager, logger: Logger.httpsUpgrade)
     }
 
+    /// Publishes the stored HTTPS upgrade data when the snapshot doesn't have it yet; later updates are published when persisted.
+    private static func publishStoredHTTPSUpgradeData(from store: AppHTTPSUpgradeStore, to snapshotStore: ProtectionDataSnapshotStore) {
+        do {
+            var builder = ProtectionDataSnapshotBuilder()
+            try store.addStoredData(to: &builder)
+            try snapshotStore.publish(builder)
+        } catch {
+            Logger.httpsUpgrade.error("Failed to publish HTTPS upgrade data: \(String(describing: error), privacy: .public)")
+        }
+    }
+
 }
@@ -290,6 +290,8 @@ enum GeneralPixel: PixelKitEventV2 {
 
     case assertionFailure(message: String, file: StaticString, line: UInt)
 
+    case cxxExceptionThrows
+
     case dbMakeDatabaseError(error: Error?)
     case dbContainerInitializationError(error: Error)
     case dbInitializationError(error: Error)
@@ -900,6 +902,9 @@ enum GeneralPixel: PixelKitEventV2 {
         case .assertionFailure:
             return "assertion_failure"
 
+        case .cxxExceptionThrows:
+            return "cxx_exception_throws"
+
         case .dbMakeDatabaseError:
             return "database_make_database_error"
         case .dbContainerInitializationError:
@@ -44,6 +44,8 @@ final class SuggestionContainer {
     }
     private let bookmarkProvider: BookmarkProvider
 
+    private let suggestionIndex: SuggestionIndex?
+
     private let startupPreferences: StartupPreferences
     private let featureFlagger: FeatureFlagger
     private let loading: SuggestionLoading
@@ -57,12 +59,13 @@ final class SuggestionContainer {
 
     private let urlSession: URLSession
 
-    init(openTabsProvider: OpenTabsProvider? = nil, suggestionLoading: SuggestionLoading? = nil, urlSession: URLSession? = nil, historyProvider: HistoryProvider, bookmarkProvider: BookmarkProvider, startupPreferences: StartupPreferences = .shared, featureFlagger: FeatureFlagger = NSApp.delegateTyped.featureFlagger, burnerMode: BurnerMode, isUrlIgnored: @escaping (URL) -> Bool,
+    init(openTabsProvider: OpenTabsProvider? = nil, suggestionLoading: SuggestionLoading? = nil, urlSession: URLSession? = nil, historyProvider: HistoryProvider, bookmarkProvider: BookmarkProvider, suggestionIndex: SuggestionIndex? = nil, startupPreferences: StartupPreferences = .shared, featureFlagger: FeatureFlagger = NSApp.delegateTyped.featureFlagger, burnerMode: BurnerMode, isUrlIgnored: @escaping (URL) -> Bool,
          windowControllersManager: WindowControllersManagerProtocol? = nil) {
         let windowControllersManager = windowControllersManager ?? WindowControllersManager.shared
         self.openTabsProvider = openTabsProvider ?? Self.defaultOpenTabsProvider(burnerMode: burnerMode, windowControllersManager: windowControllersManager)
         self.bookmarkProvider = bookmarkProvider
         self.historyProvider = historyProvider
+        self.suggestionIndex = suggestionIndex
         self.startupPreferences = startupPreferences
         self.featureFlagger = featureFlagger
         self.loading = suggestionLoading ?? SuggestionLoader(urlFactory: URL.makeURL(fromSuggestionPhrase:), isUrlIgnored: isUrlIgnored)
@@ -75,6 +78,7 @@ final class SuggestionContainer {
     convenience init(burnerMode: BurnerMode, isUrlIgnored: @escaping (URL) -> Bool, windowControllersManager: WindowControllersManagerProtocol? = nil) {
         self.init(historyProvider: HistoryCoordinator.shared,
                   bookmarkProvider: LocalBookmarkManager.shared,
+                  suggestionIndex: NSApp.delegateTyped.suggestionIndexUpdater.index,
                   burnerMode: burnerMode,
                   isUrlIgnored: isUrlIgnored,
                   windowControllersManager: windowControllersManager)
@@ -150,6 +154,37 @@ extension LocalBookmarkManager: SuggestionContainer.BookmarkProvider {
         list?.bookmarks() ?? []
     }
 }
+
+/// Keeps the autocomplete index in sync with history and bookmarks.
+final class SuggestionIndexUpdater {
+
+    let index = SuggestionIndex()
+    private var cancellables = Set<AnyCancellable>()
+
+    init(historyCoordinator: HistoryCoordinating, bookmarkManager: BookmarkManager) {
+        index.updateHistory(historyCoordinator.history ?? [])
+        historyCoordinator.historyChangesPublisher
+            .sink { [index, weak historyCoordinator] change in
+                switch change {
+                case .reloaded:
+                    index.updateHistory(historyCoordinator?.history ?? [])
+                case .updated(let entry):
+                    index.updateHistoryEntry(entry)
+                case .removed(let entries):
+                    index.removeHistoryEntries(withIdentifiers: entries.map(\.identifier))
+                }
+            }
+            .store(in: &cancellables)
+
+        bookmarkManager.listPublisher
+            .sink { [index] list in
+                index.updateBookmarks(list?.bookmarks() ?? [])
+            }
+            .store(in: &cancellables)
+    }
+
+}
+
 extension SuggestionContainer: SuggestionLoadingDataSource {
 
     var platform: Platform {
@@ -203,6 +238,10 @@ extension SuggestionContainer: SuggestionLoadingDataSource {
         bookmarkProvider.bookmarks(for: suggestionLoading)
     }
 
+    func suggestionIndex(for suggestionLoading: SuggestionLoading) -> SuggestionIndex? {
+        suggestionIndex
+    }
+
     @MainActor func openTabs(for suggestionLoading: any Suggestions.SuggestionLoading) -> [any Suggestions.BrowserTab] {
         guard featureFlagger.isFeatureOn(.autocompleteTabs) else { return [] }
         return openTabsProvider()
@@ -125,7 +125,7 @@ final class PrivacyDashboardTabExtension {
     private func makePrivacyInfo(url: URL) -> PrivacyInfo? {
         guard let host = url.host else { return nil }
 
-        let entity = contentBlocking.trackerDataManager.trackerData.findParentEntityOrFallback(forHost: host)
+        let entity = contentBlocking.trackerDataManager.trackerDataIndex.findParentEntityOrFallback(forHost: host)
 
         privacyInfo = PrivacyInfo(url: url,
                                   parentEntity: entity,
@@ -18,6 +18,7 @@
 
 import XCTest
 import BrowserServicesKit
+import Combine
 import Common
 import History
 @testable import DuckDuckGo_Privacy_Browser
@@ -30,8 +31,12 @@ final class HistoryCoordinatingMock: HistoryCoordinating {
 
     var history: BrowsingHistory?
     var allHistoryVisits: [Visit]?
-    @Published private(set) var historyDictionary: [URL: HistoryEntry]?
-    var historyDictionaryPublisher: Published<[URL: HistoryEntry]?>.Publisher { $historyDictionary }
+    private(set) var historyDictionary: [URL: HistoryEntry]?
+
+    let historyChangesSubject = PassthroughSubject<HistoryChange, Never>()
+    var historyChangesPublisher: AnyPublisher<HistoryChange, Never> {
+        historyChangesSubject.eraseToAnyPublisher()
+    }
 
     var addVisitCalled = false
     var visit: Visit?